@@ -0,0 +1,146 @@
+#include "arena.h"
+#include "lockstat.h"
+#include <pthread.h>
+#include <stdatomic.h>
+#include <stdlib.h>
+
+// Blok narciarzy wydzielanych kolejno z areny
+typedef struct Slab {
+    struct Slab* next;
+    int used;                              // Wydzielone rekordy
+    Skier skiers[ARENA_SLAB_SKIERS];
+} Slab;
+
+// Lista wolnych rekordów wątku (bez blokad)
+typedef struct {
+    Skier* head;
+    int count;
+    unsigned generation;  // Pokolenie areny, z którego pochodzą rekordy
+} SkierCache;
+
+static pthread_mutex_t arena_mutex = PTHREAD_MUTEX_INITIALIZER;
+static Slab* slabs = NULL;         // Wszystkie bloki areny
+static Slab* current_slab = NULL;  // Blok, z którego wydzielane są nowe rekordy
+static long slab_count = 0;
+static Skier* free_list = NULL;    // Rekordy oddane przez wątki (arena_mutex)
+static atomic_uint generation = 1; // Zmienia się przy zwolnieniu całej areny
+
+static __thread SkierCache cache;
+
+// Rekordy z poprzedniego pokolenia areny są nieważne
+static void check_generation(void) {
+    unsigned current = atomic_load_explicit(&generation, memory_order_acquire);
+    if (cache.generation != current) {
+        cache.head = NULL;
+        cache.count = 0;
+        cache.generation = current;
+    }
+}
+
+// Uzupełnienie listy wątku: najpierw oddane rekordy, potem nowe z bloku (wymaga arena_mutex)
+static void refill_locked(void) {
+    while (cache.count < ARENA_BATCH && free_list) {
+        Skier* skier = free_list;
+        free_list = skier->next;
+        skier->next = cache.head;
+        cache.head = skier;
+        cache.count++;
+    }
+    while (cache.count < ARENA_BATCH) {
+        if (!current_slab || current_slab->used == ARENA_SLAB_SKIERS) {
+            Slab* next = current_slab ? current_slab->next : slabs;
+            if (!next) {
+                next = malloc(sizeof(Slab));
+                if (!next) {
+                    return;
+                }
+                next->next = NULL;
+                if (current_slab) {
+                    current_slab->next = next;
+                } else {
+                    slabs = next;
+                }
+                slab_count++;
+            }
+            next->used = 0;
+            current_slab = next;
+        }
+        Skier* skier = &current_slab->skiers[current_slab->used++];
+        skier->next = cache.head;
+        cache.head = skier;
+        cache.count++;
+    }
+}
+
+// Przydział rekordu narciarza; w stanie ustalonym bez wywołań malloc
+Skier* skier_alloc(void) {
+    check_generation();
+    if (!cache.head) {
+        LOCK_MUTEX(&arena_mutex, LOCK_ARENA, 0);
+        check_generation();
+        refill_locked();
+        pthread_mutex_unlock(&arena_mutex);
+        if (!cache.head) {
+            return NULL;
+        }
+    }
+    Skier* skier = cache.head;
+    cache.head = skier->next;
+    cache.count--;
+    return skier;
+}
+
+// Zwrot rekordu do listy wątku; nadmiar wraca do areny jedną partią
+void skier_free(Skier* skier) {
+    check_generation();
+    skier->next = cache.head;
+    cache.head = skier;
+    cache.count++;
+    if (cache.count < 2 * ARENA_BATCH) {
+        return;
+    }
+
+    LOCK_MUTEX(&arena_mutex, LOCK_ARENA, 0);
+    while (cache.count > ARENA_BATCH) {
+        Skier* returned = cache.head;
+        cache.head = returned->next;
+        cache.count--;
+        returned->next = free_list;
+        free_list = returned;
+    }
+    pthread_mutex_unlock(&arena_mutex);
+}
+
+// Zwolnienie wszystkich rekordów naraz po zakończeniu dnia (żaden narciarz nie może być aktywny)
+void skier_arena_reset(void) {
+    LOCK_MUTEX(&arena_mutex, LOCK_ARENA, 0);
+    for (Slab* slab = slabs; slab; slab = slab->next) {
+        slab->used = 0;
+    }
+    current_slab = NULL;
+    free_list = NULL;
+    atomic_fetch_add_explicit(&generation, 1, memory_order_release);
+    pthread_mutex_unlock(&arena_mutex);
+}
+
+// Oddanie pamięci areny systemowi
+void skier_arena_destroy(void) {
+    LOCK_MUTEX(&arena_mutex, LOCK_ARENA, 0);
+    while (slabs) {
+        Slab* next = slabs->next;
+        free(slabs);
+        slabs = next;
+    }
+    current_slab = NULL;
+    slab_count = 0;
+    free_list = NULL;
+    atomic_fetch_add_explicit(&generation, 1, memory_order_release);
+    pthread_mutex_unlock(&arena_mutex);
+}
+
+long skier_arena_slabs(void) {
+    LOCK_MUTEX(&arena_mutex, LOCK_ARENA, 0);
+    long count = slab_count;
+    pthread_mutex_unlock(&arena_mutex);
+    return count;
+}
@@ -0,0 +1,16 @@
+#ifndef ARENA_H
+#define ARENA_H
+
+#include "station.h"
+
+#define ARENA_SLAB_SKIERS 256  // Narciarzy w jednym bloku areny
+#define ARENA_BATCH 32         // Narciarzy przenoszonych naraz między wątkiem a areną
+
+// Funkcje areny narciarzy
+Skier* skier_alloc(void);
+void skier_free(Skier* skier);
+void skier_arena_reset(void);
+void skier_arena_destroy(void);
+long skier_arena_slabs(void);
+
+#endif
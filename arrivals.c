@@ -0,0 +1,337 @@
+#include "arrivals.h"
+#include "config.h"
+#include "rng.h"
+#include <ctype.h>
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define ARRIVALS_LINE_MAX 256
+#define ARRIVALS_DEFAULT_GAP_MS 2000  // Średni odstęp przybyć bez podanego natężenia (czas rzeczywisty)
+
+static const char* process_names[ARRIVALS_PROCESSES] = { "uniform", "poisson", "profile", "burst", "replay" };
+
+static ArrivalProcess process = ARRIVALS_UNIFORM;
+static double rate = -1;                          // Narciarze na godzinę (-1: parametr arrival_rate)
+static double profile[ARRIVALS_MAX_HOURS];        // Względne natężenie kolejnych godzin od otwarcia
+static int profile_hours;                         // 0: profil domyślny (poranny szczyt, spokojny koniec dnia)
+static const char* replay_path;
+static sim_time_t* replay_times;                  // Przejścia z pliku (od otwarcia stacji, posortowane)
+static int replay_count;
+
+// Stan generatora bieżącego dnia
+static Rng rng;
+static sim_time_t day_length;
+static double clock_s;                            // Czas ostatniego wygenerowanego przybycia
+static bool day_started;                          // Czy wygenerowano już przybycie w chwili otwarcia
+static bool day_over;
+static double weights[ARRIVALS_MAX_HOURS];        // Profil znormalizowany do średniej 1 w godzinach pracy
+static int day_hours;
+static double max_weight;
+static int bus_left;                              // Pasażerowie bieżącego autobusu do wygenerowania
+static int replay_next;
+
+// Natężenie w narciarzach na sekundę; bez podanego wynosi średnio jednego narciarza na 2 s rzeczywiste
+static double rate_per_second(void) {
+    double per_hour = rate >= 0 ? rate : config.arrival_rate;
+    if (per_hour > 0) {
+        return per_hour / 3600.0;
+    }
+    return 1000.0 / ((double)ARRIVALS_DEFAULT_GAP_MS * config.sim_seconds_per_step);
+}
+
+// Odstęp procesu Poissona o podanym natężeniu
+static double exponential_gap(double per_second) {
+    return -log(1.0 - rng_unit(&rng)) / per_second;
+}
+
+static int compare_times(const void* a, const void* b) {
+    sim_time_t x = *(const sim_time_t*)a;
+    sim_time_t y = *(const sim_time_t*)b;
+    return (x > y) - (x < y);
+}
+
+// Czas z pierwszej kolumny: "HH:MM[:SS]" (także po dacie, np. "2025-01-18 08:15:02") albo sekundy od otwarcia
+static int parse_time(char* field, sim_time_t* out) {
+    char* time = field;
+    for (char* c = field; *c; c++) {
+        if (*c == ' ' || *c == 'T') {
+            time = c + 1;
+        }
+    }
+    int hours, minutes, seconds = 0;
+    if (strchr(time, ':')) {
+        if (sscanf(time, "%d:%d:%d", &hours, &minutes, &seconds) < 2) {
+            return -1;
+        }
+        *out = (sim_time_t)(hours - config.opening_hour) * 3600 + minutes * 60 + seconds;
+        return 0;
+    }
+    char* end;
+    double value = strtod(time, &end);
+    if (end == time) {
+        return -1;
+    }
+    *out = (sim_time_t)value;
+    return 0;
+}
+
+// Wczytanie znaczników czasu przejść; wiersze bez czasu (nagłówek, komentarze) są pomijane
+static int load_replay(const char* path) {
+    FILE* file = fopen(path, "r");
+    if (!file) {
+        fprintf(stderr, "Blad: Nie udalo sie otworzyc pliku przybyc %s.\n", path);
+        return -1;
+    }
+    sim_time_t limit = (sim_time_t)(config.closing_hour - config.opening_hour) * 3600;
+    int capacity = 1024;
+    sim_time_t* times = malloc(sizeof(sim_time_t) * capacity);
+    int count = 0;
+    int skipped = 0;
+    char line[ARRIVALS_LINE_MAX];
+    while (times && fgets(line, sizeof(line), file)) {
+        char* field = line;
+        while (isspace((unsigned char)*field)) {
+            field++;
+        }
+        if (!isdigit((unsigned char)*field)) {
+            continue;
+        }
+        field[strcspn(field, ",;\r\n")] = '\0';
+        sim_time_t time;
+        if (parse_time(field, &time) == -1 || time < 0 || time >= limit) {
+            skipped++; // Poza godzinami pracy stacji
+            continue;
+        }
+        if (count == capacity) {
+            capacity *= 2;
+            sim_time_t* grown = realloc(times, sizeof(sim_time_t) * capacity);
+            if (!grown) {
+                free(times);
+                times = NULL;
+                break;
+            }
+            times = grown;
+        }
+        times[count++] = time;
+    }
+    fclose(file);
+    if (!times) {
+        fprintf(stderr, "Blad: Brak pamieci na przybycia z pliku %s.\n", path);
+        return -1;
+    }
+    if (count == 0) {
+        fprintf(stderr, "Blad: Plik %s nie zawiera przybyc w godzinach pracy stacji.\n", path);
+        free(times);
+        return -1;
+    }
+    if (skipped > 0) {
+        fprintf(stderr, "Uwaga: Pominieto %d przybyc spoza godzin pracy stacji z pliku %s.\n", skipped, path);
+    }
+    qsort(times, count, sizeof(sim_time_t), compare_times);
+    free(replay_times);
+    replay_times = times;
+    replay_count = count;
+    replay_path = path;
+    return 0;
+}
+
+// Profil w postaci listy wag kolejnych godzin, np. "3,2,1,1,0.5"
+static int parse_profile(const char* list) {
+    int hours = 0;
+    double total = 0;
+    const char* text = list;
+    char* end = (char*)text;
+    while (hours < ARRIVALS_MAX_HOURS) {
+        double weight = strtod(text, &end);
+        if (end == text || weight < 0) {
+            break;
+        }
+        profile[hours++] = weight;
+        total += weight;
+        if (*end != ',') {
+            break;
+        }
+        text = end + 1;
+    }
+    if (*end != '\0' || hours == 0 || total <= 0) {
+        fprintf(stderr, "Blad: Nieprawidlowy profil przybyc: %s.\n", list);
+        return -1;
+    }
+    profile_hours = hours;
+    return 0;
+}
+
+// Opcje generatora przybyć (pozostałe opcje programu są pomijane)
+int arrivals_parse_args(int argc, char* argv[]) {
+    const char* path = NULL;
+    bool process_set = false;
+    for (int i = 1; i < argc; i++) {
+        if (strcmp(argv[i], "--arrivals") == 0 && i + 1 < argc) {
+            const char* name = argv[++i];
+            int p;
+            for (p = 0; p < ARRIVALS_PROCESSES && strcmp(name, process_names[p]) != 0; p++) {
+            }
+            if (p == ARRIVALS_PROCESSES) {
+                fprintf(stderr, "Blad: Nieznany proces przybyc: %s.\n", name);
+                return -1;
+            }
+            process = (ArrivalProcess)p;
+            process_set = true;
+        } else if (strcmp(argv[i], "--arrivals-file") == 0 && i + 1 < argc) {
+            path = argv[++i];
+        } else if (strcmp(argv[i], "--arrival-profile") == 0 && i + 1 < argc) {
+            if (parse_profile(argv[++i]) == -1) {
+                return -1;
+            }
+        }
+    }
+    if (path && !process_set) {
+        process = ARRIVALS_REPLAY;
+    }
+    if (process == ARRIVALS_REPLAY) {
+        if (!path) {
+            fprintf(stderr, "Blad: Proces replay wymaga pliku --arrivals-file.\n");
+            return -1;
+        }
+        return load_replay(path);
+    }
+    return 0;
+}
+
+// Czy opcja (z argumentem) należy do generatora przybyć
+bool arrivals_is_option(const char* arg) {
+    return strcmp(arg, "--arrivals") == 0 || strcmp(arg, "--arrivals-file") == 0 ||
+           strcmp(arg, "--arrival-profile") == 0;
+}
+
+// Natężenie podane przez program (pierwszeństwo przed parametrem arrival_rate)
+void arrivals_set_rate(double skiers_per_hour) {
+    rate = skiers_per_hour;
+}
+
+const char* arrivals_process_name(void) {
+    return process_names[process];
+}
+
+void arrivals_print_settings(void) {
+    if (process == ARRIVALS_REPLAY) {
+        printf("Przybycia: %s, %d przejsc z pliku %s.\n", process_names[process], replay_count, replay_path);
+        return;
+    }
+    printf("Przybycia: %s, %.1f narciarzy/h", process_names[process], rate_per_second() * 3600.0);
+    if (process == ARRIVALS_BURST) {
+        printf(", autobusy po srednio %d osob", config.bus_size);
+    }
+    printf(".\n");
+}
+
+// Strumień losowy przybyć (kontynuowany przez kolejne dni)
+void arrivals_init(void) {
+    rng_init(&rng, RNG_STREAM_ARRIVALS);
+}
+
+// Początek dnia: zegar generatora od chwili otwarcia i profil dopasowany do godzin pracy
+void arrivals_begin_day(void) {
+    day_length = (sim_time_t)(config.closing_hour - config.opening_hour) * 3600;
+    clock_s = 0;
+    day_started = false;
+    day_over = false;
+    bus_left = 0;
+    replay_next = 0;
+
+    int hours = (int)((day_length + 3599) / 3600);
+    day_hours = hours;
+    double total = 0;
+    for (int h = 0; h < hours; h++) {
+        if (profile_hours > 0) {
+            weights[h] = profile[h < profile_hours ? h : profile_hours - 1];
+        } else {
+            weights[h] = h == 0 ? 2.0 : h == hours - 1 ? 0.5 : 1.0; // Poranny szczyt i spokojna ostatnia godzina
+        }
+        total += weights[h];
+    }
+    max_weight = 0;
+    for (int h = 0; h < hours; h++) {
+        weights[h] = total > 0 ? weights[h] * hours / total : 1.0;
+        if (weights[h] > max_weight) {
+            max_weight = weights[h];
+        }
+    }
+}
+
+static double hour_weight(double time) {
+    int hour = (int)(time / 3600);
+    return weights[hour < day_hours ? hour : day_hours - 1];
+}
+
+// Kolejne przybycie procesu; false po końcu dnia
+static bool next_arrival(sim_time_t* time) {
+    switch (process) {
+    case ARRIVALS_UNIFORM:
+        // Pierwszy narciarz w chwili otwarcia, kolejne po losowych odstępach liczonych bez zaokrąglania
+        if (day_started) {
+            double per_hour = rate >= 0 ? rate : config.arrival_rate;
+            if (per_hour > 0) {
+                // Przy dużym natężeniu odstęp zaokrąglony do zera zatrzymałby zegar przybyć
+                double mean_gap = 3600.0 / per_hour;
+                clock_s += mean_gap * (0.25 + 1.5 * rng_unit(&rng));
+            } else {
+                int gap_ms = rng_below(&rng, 3000) + 500; // Od 500 ms do 3.5 sekundy
+                clock_s += (double)gap_ms * config.sim_seconds_per_step / 1000;
+            }
+        }
+        day_started = true;
+        break;
+    case ARRIVALS_POISSON:
+        clock_s += exponential_gap(rate_per_second());
+        break;
+    case ARRIVALS_PROFILE:
+        // Przerzedzanie: kandydaci z natężeniem maksymalnym, przyjmowani z prawdopodobieństwem waga / maksimum
+        do {
+            clock_s += exponential_gap(rate_per_second() * max_weight);
+        } while (clock_s < day_length && rng_unit(&rng) * max_weight >= hour_weight(clock_s));
+        break;
+    case ARRIVALS_BURST:
+        // Autobus przywozi od połowy do półtora średniej liczby pasażerów, wszyscy przychodzą naraz
+        while (bus_left == 0) {
+            clock_s += exponential_gap(rate_per_second() / config.bus_size);
+            bus_left = config.bus_size / 2 + rng_below(&rng, config.bus_size + 1);
+        }
+        bus_left--;
+        break;
+    case ARRIVALS_REPLAY:
+        if (replay_next == replay_count) {
+            return false;
+        }
+        *time = replay_times[replay_next++];
+        return true;
+    default:
+        return false;
+    }
+    if (clock_s >= day_length) {
+        return false; // W chwili zamknięcia bramki już nie wpuszczają
+    }
+    *time = (sim_time_t)clock_s;
+    return true;
+}
+
+// Wygenerowanie z wyprzedzeniem do max kolejnych przybyć; 0 oznacza koniec przybyć w tym dniu
+int arrivals_fill(sim_time_t* times, int max) {
+    int count = 0;
+    while (count < max && !day_over) {
+        if (!next_arrival(&times[count])) {
+            day_over = true;
+            break;
+        }
+        count++;
+    }
+    return count;
+}
+
+void arrivals_destroy(void) {
+    free(replay_times);
+    replay_times = NULL;
+    replay_count = 0;
+}
@@ -0,0 +1,34 @@
+#ifndef ARRIVALS_H
+#define ARRIVALS_H
+
+#include <stdbool.h>
+#include "des.h"
+
+#define ARRIVALS_BATCH 4096       // Przybyć generowanych z wyprzedzeniem jednym wywołaniem
+#define ARRIVALS_PER_TASK 1024    // Przybyć wpuszczanych jednym zadaniem, zanim ustąpi ono innym zadaniom
+#define ARRIVALS_MAX_HOURS 24     // Godzin profilu natężenia
+
+// Proces przybyć narciarzy
+typedef enum {
+    ARRIVALS_UNIFORM,  // Odstępy od 0.25 do 1.75 średniego (dotychczasowy generator)
+    ARRIVALS_POISSON,  // Proces Poissona o stałym natężeniu
+    ARRIVALS_PROFILE,  // Proces Poissona o natężeniu zależnym od godziny (profil dnia)
+    ARRIVALS_BURST,    // Autobusy przyjeżdżające procesem Poissona, cała grupa naraz
+    ARRIVALS_REPLAY,   // Znaczniki czasu przejść z pliku CSV
+    ARRIVALS_PROCESSES
+} ArrivalProcess;
+
+// Wybór procesu z linii poleceń: --arrivals nazwa, --arrivals-file plik.csv, --arrival-profile w1,w2,...
+int arrivals_parse_args(int argc, char* argv[]);
+bool arrivals_is_option(const char* arg);
+void arrivals_set_rate(double skiers_per_hour);
+const char* arrivals_process_name(void);
+void arrivals_print_settings(void);
+
+// Generator przybyć kolejnych dni (czasy w sekundach symulowanych od otwarcia stacji, niemalejące)
+void arrivals_init(void);
+void arrivals_begin_day(void);
+int arrivals_fill(sim_time_t* times, int max);
+void arrivals_destroy(void);
+
+#endif
@@ -0,0 +1,150 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+#include "station.h"
+#include "des.h"
+#include "hist.h"
+#include "ledger.h"
+#include "trace.h"
+#include "usage.h"
+#include "arrivals.h"
+#include "config.h"
+#include "rng.h"
+#include "arena.h"
+
+// Test wydajności stacji: symulacja zdarzeń dyskretnych bez dziennika, wynik jako jeden wiersz JSON
+
+#define BENCH_DEFAULT_SKIERS 10000
+#define BENCH_DEFAULT_RATE 600.0   // Narciarzy na godzinę
+#define BENCH_DEFAULT_DAYS 100000  // Górny limit dni, zwykle kończy go limit narciarzy
+#define BENCH_DEFAULT_SEED 1
+#define BENCH_LEDGER_TEMPLATE "/tmp/ski_bench.%d.ledger" // Księga bez --ledger: plik tymczasowy usuwany od razu
+
+static double cpu_seconds(void) {
+    struct timespec now;
+    clock_gettime(CLOCK_PROCESS_CPUTIME_ID, &now);
+    return now.tv_sec + now.tv_nsec / 1e9;
+}
+
+static double wall_seconds(void) {
+    struct timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return now.tv_sec + now.tv_nsec / 1e9;
+}
+
+static void usage(const char* program) {
+    fprintf(stderr, "Uzycie: %s [--skiers N] [--rate narciarzy_na_h] [--days N] [--seed N] [--output plik] [--ledger plik]\n"
+                    "       [--trace plik] [--arrivals proces] [--arrivals-file plik.csv] [--arrival-profile wagi]\n"
+                    "       [--config plik] [--set klucz=wartosc]...\n", program);
+}
+
+int main(int argc, char* argv[]) {
+
+    if (config_parse_args(&config, argc, argv) == -1 || arrivals_parse_args(argc, argv) == -1) {
+        exit(EXIT_FAILURE);
+    }
+
+    int skiers = BENCH_DEFAULT_SKIERS;
+    double rate = BENCH_DEFAULT_RATE;
+    int days = BENCH_DEFAULT_DAYS;
+    uint64_t seed = BENCH_DEFAULT_SEED;
+    const char* output_path = NULL;
+    const char* ledger_path = NULL;
+    const char* trace_path = NULL;
+    for (int i = 1; i < argc; i++) {
+        if (strcmp(argv[i], "--skiers") == 0 && i + 1 < argc) {
+            skiers = atoi(argv[++i]);
+        } else if (strcmp(argv[i], "--rate") == 0 && i + 1 < argc) {
+            rate = atof(argv[++i]);
+        } else if (strcmp(argv[i], "--days") == 0 && i + 1 < argc) {
+            days = atoi(argv[++i]);
+        } else if (strcmp(argv[i], "--seed") == 0 && i + 1 < argc) {
+            seed = strtoull(argv[++i], NULL, 10);
+        } else if (strcmp(argv[i], "--output") == 0 && i + 1 < argc) {
+            output_path = argv[++i];
+        } else if (strcmp(argv[i], "--ledger") == 0 && i + 1 < argc) {
+            ledger_path = argv[++i];
+        } else if (strcmp(argv[i], "--trace") == 0 && i + 1 < argc) {
+            trace_path = argv[++i];
+        } else if ((config_is_option(argv[i]) || arrivals_is_option(argv[i])) && i + 1 < argc) {
+            i++; // Obsłużone przez config_parse_args i arrivals_parse_args
+        } else {
+            usage(argv[0]);
+            exit(EXIT_FAILURE);
+        }
+    }
+    if (skiers <= 0 || rate <= 0 || days <= 0) {
+        fprintf(stderr, "Blad: Liczba narciarzy, czestosc przybyc i liczba dni musza byc dodatnie.\n");
+        exit(EXIT_FAILURE);
+    }
+
+    char temp_ledger[64];
+    if (!ledger_path) {
+        snprintf(temp_ledger, sizeof(temp_ledger), BENCH_LEDGER_TEMPLATE, (int)getpid());
+    }
+    if (ledger_open(ledger_path ? ledger_path : temp_ledger) == -1) {
+        fprintf(stderr, "Blad: Nie udalo sie utworzyc ksiegi przejazdow %s.\n", ledger_path ? ledger_path : temp_ledger);
+        exit(EXIT_FAILURE);
+    }
+    if (!ledger_path) {
+        unlink(temp_ledger); // Odwzorowanie zostaje do końca testu, plik znika z dysku
+    }
+    if (trace_path && trace_open(trace_path) == -1) {
+        fprintf(stderr, "Blad: Nie udalo sie utworzyc sladu zdarzen %s.\n", trace_path);
+        exit(EXIT_FAILURE);
+    }
+    rng_set_seed(seed);
+    station_set_arrivals(rate, skiers);
+
+    double cpu_start = cpu_seconds();
+    double wall_start = wall_seconds();
+    int simulated_days = des_run_season(days, false);
+    double cpu_used = cpu_seconds() - cpu_start;
+    double wall_used = wall_seconds() - wall_start;
+
+    StationTotals totals = station_totals();
+    static Histogram wait, chair_wait, chair_wait_vip, descent;
+    hist_snapshot(HIST_TOTAL_WAIT, &wait);
+    hist_snapshot(HIST_CHAIR_WAIT, &chair_wait);
+    hist_snapshot(HIST_CHAIR_WAIT_VIP, &chair_wait_vip);
+    hist_snapshot(HIST_DESCENT, &descent);
+
+    FILE* out = stdout;
+    if (output_path) {
+        out = fopen(output_path, "a");
+        if (!out) {
+            fprintf(stderr, "Blad: Nie udalo sie otworzyc pliku wynikow %s.\n", output_path);
+            exit(EXIT_FAILURE);
+        }
+    }
+    fprintf(out,
+            "{\"skiers\":%ld,\"rate\":%.1f,\"arrivals\":\"%s\",\"seed\":%llu,\"days\":%d,"
+            "\"gate_skiers_per_hour\":%.1f,\"lift_seats_per_hour\":%.1f,"
+            "\"wait_p50_s\":%ld,\"wait_p95_s\":%ld,\"wait_p99_s\":%ld,\"wait_max_s\":%llu,"
+            "\"vip_seat_share\":%d,\"chair_wait_p95_s\":%ld,\"chair_wait_vip_p95_s\":%ld,"
+            "\"group_share\":%d,\"groups\":%ld,\"seats_lost_pct\":%.2f,"
+            "\"descent_p50_s\":%ld,\"descent_p95_s\":%ld,"
+            "\"cpu_us_per_skier\":%.3f,\"cpu_s\":%.6f,\"wall_s\":%.6f,\"arena_slabs\":%ld}\n",
+            totals.skiers, rate, arrivals_process_name(), (unsigned long long)seed, simulated_days,
+            totals.open_hours > 0 ? totals.gate_passes / totals.open_hours : 0.0,
+            totals.lift_hours > 0 ? totals.seats / totals.lift_hours : 0.0,
+            hist_percentile(&wait, 50), hist_percentile(&wait, 95), hist_percentile(&wait, 99),
+            (unsigned long long)wait.max,
+            config.vip_seat_share, hist_percentile(&chair_wait, 95), hist_percentile(&chair_wait_vip, 95),
+            config.group_share, totals.groups,
+            totals.seats_offered > 0 ? 100.0 * totals.seats_lost / totals.seats_offered : 0.0,
+            hist_percentile(&descent, 50), hist_percentile(&descent, 95),
+            totals.skiers > 0 ? cpu_used * 1e6 / totals.skiers : 0.0, cpu_used, wall_used, skier_arena_slabs());
+    if (out != stdout) {
+        fclose(out);
+    }
+
+    station_destroy();
+    hist_destroy();
+    usage_destroy();
+    ledger_close();
+    trace_close();
+    return 0;
+}
@@ -0,0 +1,171 @@
+#include "board.h"
+#include <stdio.h>
+#include <string.h>
+
+void skier_queue_push(SkierQueue* queue, Skier* skier) {
+    skier->next = NULL;
+    if (queue->tail) {
+        queue->tail->next = skier;
+    } else {
+        queue->head = skier;
+    }
+    queue->tail = skier;
+}
+
+Skier* skier_queue_pop(SkierQueue* queue) {
+    Skier* skier = queue->head;
+    if (skier) {
+        queue->head = skier->next;
+        if (!queue->head) {
+            queue->tail = NULL;
+        }
+        skier->next = NULL;
+    }
+    return skier;
+}
+
+// Pusty planista; liczba zarezerwowanych miejsc wynika z udziału VIP w konfiguracji
+void board_init(BoardScheduler* board, int seats_per_chair) {
+    memset(board, 0, sizeof(*board));
+    board->reserved_seats = seats_per_chair * config.vip_seat_share / 100;
+    board->aging = config.boarding_aging;
+    board->held = -1;
+}
+
+// Narciarz (z grupą, którą prowadzi) na peronie ustawia się w kolejce swojej klasy
+void board_push(BoardScheduler* board, Skier* skier) {
+    BoardClass class = skier->ticket.is_vip ? BOARD_VIP : BOARD_REGULAR;
+    skier_queue_push(&board->queues[class], skier);
+    board->waiting[class] += skier->group_size;
+}
+
+// Wyjęcie jednostki z kolejki (za poprzednikiem, NULL: z czoła) i rozsadzenie całej grupy naraz
+static int take(BoardScheduler* board, BoardClass class, Skier* prev, Skier** out) {
+    SkierQueue* queue = &board->queues[class];
+    Skier* unit;
+    if (prev) {
+        unit = prev->next;
+        prev->next = unit->next;
+        if (queue->tail == unit) {
+            queue->tail = prev;
+        }
+        unit->next = NULL;
+    } else {
+        unit = skier_queue_pop(queue);
+    }
+
+    int count = 0;
+    for (Skier* skier = unit; skier; skier = skier->group_next) {
+        out[count++] = skier;
+    }
+    board->waiting[class] -= count;
+    board->boarded[class] += count;
+    if (count > 1) {
+        board->groups++;
+        board->group_riders += count;
+    }
+    return count;
+}
+
+// Pierwsza jednostka klasy mieszcząca się na wolnych miejscach. Grupa z czoła, która się nie mieści,
+// czeka na następne krzesełko, a miejsca zajmuje narciarz lub mniejsza grupa stojąca tuż za nią
+static int take_fitting(BoardScheduler* board, BoardClass class, Skier** out, int free_seats) {
+    Skier* head = board->queues[class].head;
+    if (!head) {
+        return 0;
+    }
+    if (head->group_size <= free_seats) {
+        if (board->held == (int)class) {
+            board->held = -1;
+        }
+        return take(board, class, NULL, out);
+    }
+
+    if (board->held == -1) {
+        board->held = class;
+    }
+    Skier* prev = head;
+    for (int i = 0; i < BOARD_LOOKAHEAD && prev->next; i++, prev = prev->next) {
+        if (prev->next->group_size <= free_seats) {
+            int count = take(board, class, prev, out);
+            board->gap_fillers += count;
+            return count;
+        }
+    }
+    return 0;
+}
+
+// Czy najdłużej czekający zwykły narciarz czeka dłużej niż próg postarzania
+static bool regular_aged(const BoardScheduler* board, sim_time_t now) {
+    const Skier* head = board->queues[BOARD_REGULAR].head;
+    return board->aging > 0 && head && now - head->stage_at >= board->aging;
+}
+
+// Wybór pasażerów jednego krzesełka: najpierw grupa, która nie zmieściła się na poprzednim krzesełku,
+// potem miejsca zarezerwowane dla VIP, a pozostałe według pierwszeństwa VIP, chyba że zwykły narciarz
+// czeka dłużej niż próg postarzania. Grupa nigdy nie jest rozdzielana, a czeka najwyżej jedno krzesełko
+int board_select(BoardScheduler* board, sim_time_t now, Skier** out, int seats) {
+    int count = 0;
+    if (board->held != -1) {
+        count += take_fitting(board, (BoardClass)board->held, out, seats);
+    }
+
+    int reserved = board->reserved_seats < seats - count ? board->reserved_seats : seats - count;
+    int vip = 0;
+    while (vip < reserved) {
+        int taken = take_fitting(board, BOARD_VIP, &out[count], seats - count);
+        if (taken == 0) {
+            break;
+        }
+        vip += taken;
+        count += taken;
+    }
+    board->reserved_unused += vip < reserved ? reserved - vip : 0;
+    board->seats_offered += seats;
+
+    while (count < seats) {
+        BoardClass first = regular_aged(board, now) ? BOARD_REGULAR : BOARD_VIP;
+        int taken = take_fitting(board, first, &out[count], seats - count);
+        if (taken > 0 && first == BOARD_REGULAR) {
+            board->aged += taken;
+        } else if (taken == 0) {
+            taken = take_fitting(board, first == BOARD_VIP ? BOARD_REGULAR : BOARD_VIP, &out[count], seats - count);
+        }
+        if (taken == 0) {
+            break;
+        }
+        count += taken;
+    }
+
+    // Wolne miejsca mimo oczekujących: żadna jednostka z kolejek się nie zmieściła
+    if (count < seats && board_waiting(board) > 0) {
+        board->seats_lost += seats - count;
+    }
+    if (board->held != -1) {
+        board->held_chairs++;
+    }
+    return count;
+}
+
+int board_waiting(const BoardScheduler* board) {
+    return board->waiting[BOARD_REGULAR] + board->waiting[BOARD_VIP];
+}
+
+// Raport przepustowości klas i wykorzystania miejsc
+void board_print_report(const BoardScheduler* board, double hours) {
+    long total = board->boarded[BOARD_REGULAR] + board->boarded[BOARD_VIP];
+    printf("\n[Raport wsiadania]\n");
+    printf("- Miejsca zarezerwowane dla VIP: %d na krzeselko, postarzanie po %ld s.\n",
+           board->reserved_seats, (long)board->aging);
+    printf("- Zwykli: %ld (%.0f/h), w tym %ld dzieki postarzaniu, czeka %d.\n", board->boarded[BOARD_REGULAR],
+           hours > 0 ? board->boarded[BOARD_REGULAR] / hours : 0.0, board->aged, board->waiting[BOARD_REGULAR]);
+    printf("- VIP: %ld (%.0f/h), czeka %d.\n", board->boarded[BOARD_VIP],
+           hours > 0 ? board->boarded[BOARD_VIP] / hours : 0.0, board->waiting[BOARD_VIP]);
+    printf("- Wykorzystanie miejsc: %.1f%%, zarezerwowane miejsca bez VIP: %ld.\n",
+           board->seats_offered > 0 ? 100.0 * total / board->seats_offered : 0.0, board->reserved_unused);
+    printf("- Grupy: %ld (%ld osob, srednio %.2f), grupa z czola czekala na nastepne krzeselko: %ld razy, "
+           "wolne miejsca obok niej zajelo %ld narciarzy.\n", board->groups, board->group_riders,
+           board->groups > 0 ? (double)board->group_riders / board->groups : 0.0, board->held_chairs, board->gap_fillers);
+    printf("- Miejsca puste mimo oczekujacych (rozdrobnienie grup): %ld (%.1f%% miejsc).\n", board->seats_lost,
+           board->seats_offered > 0 ? 100.0 * board->seats_lost / board->seats_offered : 0.0);
+}
@@ -0,0 +1,50 @@
+#ifndef BOARD_H
+#define BOARD_H
+
+#include "station.h"
+
+#define BOARD_LOOKAHEAD 8 // Jednostki za grupą z czoła sprawdzane przy uzupełnianiu wolnych miejsc
+
+// Klasy narciarzy przy wsiadaniu
+typedef enum {
+    BOARD_REGULAR,
+    BOARD_VIP,
+    BOARD_CLASSES
+} BoardClass;
+
+// Kolejka FIFO zaparkowanych narciarzy (przez pole next)
+typedef struct {
+    Skier* head;
+    Skier* tail;
+} SkierQueue;
+
+// Planista wsiadania: kolejka na każdą klasę, miejsca zarezerwowane dla VIP i postarzanie zwykłych.
+// Grupa (prowadzący z członkami) zajmuje miejsca na jednym krzesełku w całości albo czeka dalej;
+// grupa z czoła kolejki, która się nie zmieściła, wsiada pierwsza na kolejne krzesełko
+typedef struct {
+    SkierQueue queues[BOARD_CLASSES]; // Prowadzący grup i pojedynczy narciarze
+    int waiting[BOARD_CLASSES];   // Narciarze czekający na krzesełko (łącznie z członkami grup)
+    int held;                     // Klasa grupy czekającej na następne krzesełko (-1: brak)
+    int reserved_seats;           // Miejsca na krzesełku zarezerwowane dla VIP
+    sim_time_t aging;             // Po tym czasie zwykły narciarz wyprzedza VIP (0: bez postarzania)
+    long boarded[BOARD_CLASSES];  // Narciarze, którzy wsiedli
+    long aged;                    // Zwykli narciarze, którzy wsiedli dzięki postarzaniu
+    long seats_offered;           // Wszystkie miejsca krzesełek w punkcie załadunku
+    long reserved_unused;         // Zarezerwowane miejsca oddane zwykłym narciarzom
+    long groups;                  // Grupy, które wsiadły
+    long group_riders;            // Osoby w tych grupach
+    long held_chairs;             // Krzesełka, na których grupa z czoła kolejki się nie zmieściła
+    long gap_fillers;             // Narciarze, którzy wyprzedzili grupę, zajmując wolne miejsca
+    long seats_lost;              // Miejsca puste mimo oczekujących (rozdrobnienie przez grupy)
+} BoardScheduler;
+
+// Funkcje kolejek i planisty (wywołujący zapewnia wzajemne wykluczanie)
+void skier_queue_push(SkierQueue* queue, Skier* skier);
+Skier* skier_queue_pop(SkierQueue* queue);
+void board_init(BoardScheduler* board, int seats_per_chair);
+void board_push(BoardScheduler* board, Skier* skier);
+int board_select(BoardScheduler* board, sim_time_t now, Skier** out, int seats);
+int board_waiting(const BoardScheduler* board);
+void board_print_report(const BoardScheduler* board, double hours);
+
+#endif
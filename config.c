@@ -0,0 +1,230 @@
+#include "config.h"
+#include <ctype.h>
+#include <errno.h>
+#include <limits.h>
+#include <stddef.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define CONFIG_LINE_MAX 256
+
+// Wartości domyślne (dawne stałe kompilacji)
+#define CONFIG_DEFAULTS {                \
+    .max_chairs = 40,                    \
+    .max_people_on_chair = 3,            \
+    .max_people_on_platform = 50,        \
+    .sim_seconds_per_step = 120,         \
+    .track_times = { 2, 4, 6 },          \
+    .num_lifts = 1,                      \
+    .num_gates = 4,                      \
+    .gate_queue_capacity = 4096,         \
+    .ride_time = 5,                      \
+    .responder_time = 2,                 \
+    .opening_hour = 8,                   \
+    .closing_hour = 10,                  \
+    .vip_seat_share = 34,                \
+    .boarding_aging = 600,               \
+    .trail_density = 10,                 \
+    .min_trail_speed = 20,               \
+    .arrival_rate = 0,                   \
+    .bus_size = 40,                      \
+    .group_share = 30,                   \
+    .family_share = 50,                  \
+}
+
+Config config = CONFIG_DEFAULTS;
+
+// Nazwa parametru i jego położenie w strukturze
+typedef struct {
+    const char* key;
+    size_t offset;
+} ConfigKey;
+
+static const ConfigKey config_keys[] = {
+    { "max_chairs", offsetof(Config, max_chairs) },
+    { "max_people_on_chair", offsetof(Config, max_people_on_chair) },
+    { "max_people_on_platform", offsetof(Config, max_people_on_platform) },
+    { "sim_seconds_per_step", offsetof(Config, sim_seconds_per_step) },
+    { "t1_time", offsetof(Config, track_times[0]) },
+    { "t2_time", offsetof(Config, track_times[1]) },
+    { "t3_time", offsetof(Config, track_times[2]) },
+    { "num_lifts", offsetof(Config, num_lifts) },
+    { "num_gates", offsetof(Config, num_gates) },
+    { "gate_queue_capacity", offsetof(Config, gate_queue_capacity) },
+    { "ride_time", offsetof(Config, ride_time) },
+    { "responder_time", offsetof(Config, responder_time) },
+    { "opening_hour", offsetof(Config, opening_hour) },
+    { "closing_hour", offsetof(Config, closing_hour) },
+    { "vip_seat_share", offsetof(Config, vip_seat_share) },
+    { "boarding_aging", offsetof(Config, boarding_aging) },
+    { "trail_density", offsetof(Config, trail_density) },
+    { "min_trail_speed", offsetof(Config, min_trail_speed) },
+    { "arrival_rate", offsetof(Config, arrival_rate) },
+    { "bus_size", offsetof(Config, bus_size) },
+    { "group_share", offsetof(Config, group_share) },
+    { "family_share", offsetof(Config, family_share) },
+};
+
+#define CONFIG_KEY_COUNT ((int)(sizeof(config_keys) / sizeof(config_keys[0])))
+
+void config_defaults(Config* cfg) {
+    Config defaults = CONFIG_DEFAULTS;
+    *cfg = defaults;
+}
+
+// Ustawienie jednego parametru po nazwie
+int config_set(Config* cfg, const char* key, const char* value) {
+    for (int i = 0; i < CONFIG_KEY_COUNT; i++) {
+        if (strcmp(key, config_keys[i].key) == 0) {
+            char* end;
+            errno = 0;
+            long number = strtol(value, &end, 10);
+            if (end == value || *end != '\0' || errno == ERANGE || number < INT_MIN || number > INT_MAX) {
+                fprintf(stderr, "Blad: Nieprawidlowa wartosc parametru %s: %s.\n", key, value);
+                return -1;
+            }
+            *(int*)((char*)cfg + config_keys[i].offset) = (int)number;
+            return 0;
+        }
+    }
+    fprintf(stderr, "Blad: Nieznany parametr konfiguracji: %s.\n", key);
+    return -1;
+}
+
+// Usunięcie białych znaków z początku i końca napisu
+static char* trim(char* text) {
+    while (isspace((unsigned char)*text)) {
+        text++;
+    }
+    char* end = text + strlen(text);
+    while (end > text && isspace((unsigned char)end[-1])) {
+        *--end = '\0';
+    }
+    return text;
+}
+
+// Wczytanie pliku w formacie "klucz = wartosc" (# rozpoczyna komentarz)
+int config_load_file(Config* cfg, const char* path) {
+    FILE* file = fopen(path, "r");
+    if (!file) {
+        fprintf(stderr, "Blad: Nie udalo sie otworzyc pliku konfiguracji %s.\n", path);
+        return -1;
+    }
+
+    char line[CONFIG_LINE_MAX];
+    int line_number = 0;
+    int result = 0;
+    while (fgets(line, sizeof(line), file)) {
+        line_number++;
+        char* comment = strchr(line, '#');
+        if (comment) {
+            *comment = '\0';
+        }
+        char* text = trim(line);
+        if (*text == '\0') {
+            continue;
+        }
+        char* equals = strchr(text, '=');
+        if (!equals) {
+            fprintf(stderr, "Blad: %s:%d: oczekiwano \"klucz = wartosc\".\n", path, line_number);
+            result = -1;
+            break;
+        }
+        *equals = '\0';
+        if (config_set(cfg, trim(text), trim(equals + 1)) == -1) {
+            fprintf(stderr, "Blad: %s:%d: nieprawidlowy wpis.\n", path, line_number);
+            result = -1;
+            break;
+        }
+    }
+    fclose(file);
+    return result;
+}
+
+// Sprawdzenie spójności parametrów
+int config_validate(const Config* cfg) {
+    for (int i = 0; i < CONFIG_KEY_COUNT; i++) {
+        int value = *(const int*)((const char*)cfg + config_keys[i].offset);
+        bool may_be_zero = strcmp(config_keys[i].key, "opening_hour") == 0 ||
+                           strcmp(config_keys[i].key, "responder_time") == 0 ||
+                           strcmp(config_keys[i].key, "vip_seat_share") == 0 ||
+                           strcmp(config_keys[i].key, "boarding_aging") == 0 ||
+                           strcmp(config_keys[i].key, "arrival_rate") == 0 ||
+                           strcmp(config_keys[i].key, "group_share") == 0 ||
+                           strcmp(config_keys[i].key, "family_share") == 0;
+        if (value < 0 || (value == 0 && !may_be_zero)) {
+            fprintf(stderr, "Blad: Parametr %s musi byc dodatni (jest %d).\n", config_keys[i].key, value);
+            return -1;
+        }
+    }
+    if (cfg->max_chairs < 2 || cfg->max_chairs % 2 != 0) {
+        fprintf(stderr, "Blad: Liczba krzeselek musi byc parzysta i nie mniejsza niz 2.\n");
+        return -1;
+    }
+    if (cfg->ride_time * cfg->sim_seconds_per_step < cfg->max_chairs / 2) {
+        fprintf(stderr, "Blad: Odstep miedzy krzeselkami musi wynosic co najmniej 1 sekunde symulowana.\n");
+        return -1;
+    }
+    if ((cfg->gate_queue_capacity & (cfg->gate_queue_capacity - 1)) != 0) {
+        fprintf(stderr, "Blad: Pojemnosc kolejki bramki musi byc potega dwojki.\n");
+        return -1;
+    }
+    if (cfg->vip_seat_share > 100) {
+        fprintf(stderr, "Blad: Udzial miejsc VIP nie moze przekraczac 100%%.\n");
+        return -1;
+    }
+    if (cfg->group_share > 100 || cfg->family_share > 100) {
+        fprintf(stderr, "Blad: Udzial grup nie moze przekraczac 100%%.\n");
+        return -1;
+    }
+    if (cfg->max_people_on_platform < cfg->max_people_on_chair) {
+        fprintf(stderr, "Blad: Peron musi pomiescic co najmniej grupe zajmujaca cale krzeselko.\n");
+        return -1;
+    }
+    if (cfg->min_trail_speed > 100) {
+        fprintf(stderr, "Blad: Predkosc na zatloczonej trasie nie moze przekraczac 100%% swobodnej.\n");
+        return -1;
+    }
+    if (cfg->closing_hour <= cfg->opening_hour || cfg->closing_hour > 24) {
+        fprintf(stderr, "Blad: Nieprawidlowe godziny pracy stacji: %d-%d.\n", cfg->opening_hour, cfg->closing_hour);
+        return -1;
+    }
+    return 0;
+}
+
+// Opcje konfiguracji z linii poleceń: --config plik, --set klucz=wartosc (w podanej kolejności)
+int config_parse_args(Config* cfg, int argc, char* argv[]) {
+    for (int i = 1; i < argc; i++) {
+        if (strcmp(argv[i], "--config") == 0 && i + 1 < argc) {
+            if (config_load_file(cfg, argv[++i]) == -1) {
+                return -1;
+            }
+        } else if (strcmp(argv[i], "--set") == 0 && i + 1 < argc) {
+            char assignment[CONFIG_LINE_MAX];
+            snprintf(assignment, sizeof(assignment), "%s", argv[++i]);
+            char* equals = strchr(assignment, '=');
+            if (!equals) {
+                fprintf(stderr, "Blad: Oczekiwano --set klucz=wartosc, otrzymano: %s.\n", argv[i]);
+                return -1;
+            }
+            *equals = '\0';
+            if (config_set(cfg, assignment, equals + 1) == -1) {
+                return -1;
+            }
+        }
+    }
+    return config_validate(cfg);
+}
+
+// Czy opcja (z argumentem) należy do konfiguracji
+bool config_is_option(const char* arg) {
+    return strcmp(arg, "--config") == 0 || strcmp(arg, "--set") == 0;
+}
+
+// Wypisanie bieżącej konfiguracji w formacie pliku
+void config_print(const Config* cfg) {
+    for (int i = 0; i < CONFIG_KEY_COUNT; i++) {
+        printf("%s = %d\n", config_keys[i].key, *(const int*)((const char*)cfg + config_keys[i].offset));
+    }
+}
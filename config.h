@@ -0,0 +1,44 @@
+#ifndef CONFIG_H
+#define CONFIG_H
+
+#include <stdbool.h>
+
+#define CONFIG_TRACKS 3 // Liczba tras (T1-T3)
+
+// Parametry stacji ustalane przy starcie (plik konfiguracyjny i opcje --set)
+typedef struct {
+    int max_chairs;             // Liczba krzesełek
+    int max_people_on_chair;    // Liczba miejsc na jednym krzesełku
+    int max_people_on_platform; // Maksymalna liczba osób na peronie
+    int sim_seconds_per_step;   // Sekundy symulowane na 1 sekundę czasu rzeczywistego
+    int track_times[CONFIG_TRACKS]; // Czas przejazdu tras T1-T3 (w sekundach)
+    int num_lifts;              // Liczba kolejek (każda z własnymi bramkami, peronem i pracownikami)
+    int num_gates;              // Liczba bramek jednej kolejki
+    int gate_queue_capacity;    // Pojemność kolejki jednej bramki (potęga dwójki)
+    int ride_time;              // Czas jazdy krzesełkiem (w sekundach)
+    int responder_time;         // Czas sprawdzania gotowości przez drugiego pracownika (w sekundach)
+    int opening_hour;           // Godzina otwarcia stacji
+    int closing_hour;           // Godzina zamknięcia stacji
+    int vip_seat_share;         // Procent miejsc krzesełka zarezerwowanych dla VIP
+    int boarding_aging;         // Czas oczekiwania na peronie, po którym zwykły narciarz wyprzedza VIP (0: bez)
+    int trail_density;          // Narciarze na minutę swobodnego zjazdu, przy których trasa jest zakorkowana
+    int min_trail_speed;        // Prędkość na zatłoczonej trasie (procent prędkości swobodnej)
+    int arrival_rate;           // Przybywający narciarze na godzinę (0: średnio co 2 s czasu rzeczywistego)
+    int bus_size;               // Średnia liczba pasażerów autobusu (proces przybyć burst)
+    int group_share;            // Procent przybywających z grupą (opiekun z dziećmi albo znajomi)
+    int family_share;           // Procent grup prowadzonych przez opiekuna (18-65 lat), w których są jego dzieci
+} Config;
+
+// Bieżąca konfiguracja (tylko do odczytu po starcie symulacji)
+extern Config config;
+
+// Funkcje konfiguracji
+void config_defaults(Config* cfg);
+int config_set(Config* cfg, const char* key, const char* value);
+int config_load_file(Config* cfg, const char* path);
+int config_validate(const Config* cfg);
+int config_parse_args(Config* cfg, int argc, char* argv[]);
+bool config_is_option(const char* arg);
+void config_print(const Config* cfg);
+
+#endif
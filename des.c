@@ -0,0 +1,210 @@
+#include "des.h"
+#include "station.h"
+#include "log.h"
+#include "arena.h"
+#include <stdatomic.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+#define DES_INITIAL_CAPACITY 64
+
+// Czy zdarzenie a zachodzi przed zdarzeniem b
+static bool event_before(const DesEvent* a, const DesEvent* b) {
+    return a->time < b->time || (a->time == b->time && a->seq < b->seq);
+}
+
+// Inicjalizacja silnika
+int des_init(Des* des) {
+    des->heap = malloc(sizeof(DesEvent) * DES_INITIAL_CAPACITY);
+    if (!des->heap) {
+        return -1;
+    }
+    des->size = 0;
+    des->capacity = DES_INITIAL_CAPACITY;
+    des->next_seq = 0;
+    des->now = 0;
+    return 0;
+}
+
+// Zwolnienie kopca zdarzeń
+void des_destroy(Des* des) {
+    free(des->heap);
+    des->heap = NULL;
+    des->size = 0;
+    des->capacity = 0;
+}
+
+// Zaplanowanie zdarzenia za 'delay' sekund symulowanych
+int des_schedule(Des* des, sim_time_t delay, DesHandler handler, void* arg) {
+    if (des->size == des->capacity) {
+        DesEvent* heap = realloc(des->heap, sizeof(DesEvent) * des->capacity * 2);
+        if (!heap) {
+            return -1;
+        }
+        des->heap = heap;
+        des->capacity *= 2;
+    }
+
+    DesEvent event = { des->now + delay, des->next_seq++, handler, arg };
+    int i = des->size++;
+    while (i > 0) {
+        int parent = (i - 1) / 2;
+        if (!event_before(&event, &des->heap[parent])) {
+            break;
+        }
+        des->heap[i] = des->heap[parent];
+        i = parent;
+    }
+    des->heap[i] = event;
+    return 0;
+}
+
+// Zdjęcie najbliższego zdarzenia z kopca
+bool des_pop(Des* des, DesEvent* out) {
+    if (des->size == 0) {
+        return false;
+    }
+
+    *out = des->heap[0];
+    DesEvent last = des->heap[--des->size];
+    int i = 0;
+    while (true) {
+        int child = 2 * i + 1;
+        if (child >= des->size) {
+            break;
+        }
+        if (child + 1 < des->size && event_before(&des->heap[child + 1], &des->heap[child])) {
+            child++;
+        }
+        if (!event_before(&des->heap[child], &last)) {
+            break;
+        }
+        des->heap[i] = des->heap[child];
+        i = child;
+    }
+    if (des->size > 0) {
+        des->heap[i] = last;
+    }
+    des->now = out->time;
+    return true;
+}
+
+// Przeskok zegara do najbliższego zdarzenia i jego obsługa
+bool des_step(Des* des) {
+    DesEvent event;
+    if (!des_pop(des, &event)) {
+        return false;
+    }
+    event.handler(event.arg);
+    return true;
+}
+
+// Obsługa zdarzeń aż do opróżnienia kolejki
+void des_run(Des* des) {
+    while (des_step(des)) {
+    }
+}
+
+// Silnik bieżącego dnia symulacji
+static Des season_des;
+
+static sim_time_t des_now(void) {
+    return season_des.now;
+}
+
+// Zaplanowanie zdarzenia, brak pamięci kończy program
+static void des_schedule_event(sim_time_t delay, DesHandler handler, void* arg) {
+    if (des_schedule(&season_des, delay, handler, arg) == -1) {
+        fprintf(stderr, "Blad: Nie udalo sie zaplanowac zdarzenia symulacji.\n");
+        exit(EXIT_FAILURE);
+    }
+}
+
+static const Scheduler des_scheduler = { des_now, des_schedule_event };
+static Rng* worker_rngs; // Strumień losowy pracownika każdej kolejki (indeks = numer kolejki)
+static atomic_bool stop_requested; // Przerwanie sezonu: zamknięcie stacji w bieżącym dniu (nigdy nie kasowane)
+
+static void on_lift_resume(void* arg);
+
+// Obsługa zdarzeń dnia; przerwanie sprawdzane między zdarzeniami zamyka bramki od razu,
+// a narciarze już na stacji kończą dzień w czasie wirtualnym
+static void run_day(void) {
+    bool closing = false;
+    while (des_step(&season_des)) {
+        if (!closing && atomic_load(&stop_requested)) {
+            closing = true;
+            station_close();
+        }
+    }
+}
+
+// Pracownik co krok symulacji może zatrzymać swoją kolejkę
+static void on_worker_tick(void* arg) {
+    Rng* rng = arg;
+    int lift_id = (int)(rng - worker_rngs);
+    if (!is_station_open) {
+        return;
+    }
+
+    if (rng_below(rng, 10) == 0) { // 10% szans na zatrzymanie kolejki
+        stop_lift(lift_id, LIFT_WORKER_ID(lift_id));
+        des_schedule_event(config.responder_time * config.sim_seconds_per_step, on_lift_resume, rng);
+    } else {
+        des_schedule_event(config.sim_seconds_per_step, on_worker_tick, rng);
+    }
+}
+
+// Wznowienie kolejki po odpowiedzi drugiego pracownika
+static void on_lift_resume(void* arg) {
+    Rng* rng = arg;
+    int lift_id = (int)(rng - worker_rngs);
+    resume_lift(lift_id, LIFT_WORKER_ID(lift_id));
+    des_schedule_event(config.sim_seconds_per_step, on_worker_tick, rng);
+}
+
+// Symulacja kolejnych dni sezonu
+int des_run_season(int days, bool print_days) {
+    if (station_init(&des_scheduler) == -1) {
+        fprintf(stderr, "Blad: Nie udalo sie zainicjalizowac stacji.\n");
+        return 0;
+    }
+    worker_rngs = malloc(sizeof(Rng) * config.num_lifts);
+    if (!worker_rngs) {
+        fprintf(stderr, "Blad: Nie udalo sie przydzielic pamieci dla pracownikow.\n");
+        return 0;
+    }
+    for (int l = 0; l < config.num_lifts; l++) {
+        rng_init(&worker_rngs[l], RNG_STREAM_WORKER + LIFT_WORKER_ID(l));
+    }
+
+    int day;
+    for (day = 1; day <= days && !station_arrivals_exhausted() && !atomic_load(&stop_requested); day++) {
+        if (des_init(&season_des) == -1) {
+            fprintf(stderr, "Blad: Nie udalo sie zainicjalizowac kolejki zdarzen.\n");
+            break;
+        }
+
+        station_open_day();
+        for (int l = 0; l < config.num_lifts; l++) {
+            des_schedule_event(0, on_worker_tick, &worker_rngs[l]);
+        }
+        run_day();
+
+        log_flush();
+        if (print_days) {
+            StationStats stats = station_day_stats();
+            printf("[Dzien %d] Narciarze: %d, zjazdy: %d, zatrzymania kolejki: %d.\n",
+                   day, stats.skiers, stats.rides, stats.lift_stops);
+        }
+        des_destroy(&season_des);
+        skier_arena_reset(); // Wszyscy narciarze zakończyli dzień
+    }
+    free(worker_rngs);
+    worker_rngs = NULL;
+    return day - 1;
+}
+
+// Zamknięcie stacji przy najbliższym zdarzeniu i koniec sezonu po tym dniu (z innego wątku, np. po SIGINT)
+void des_request_stop(void) {
+    atomic_store(&stop_requested, true);
+}
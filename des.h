@@ -0,0 +1,42 @@
+#ifndef DES_H
+#define DES_H
+
+#include <stdbool.h>
+
+// Czas wirtualny (w sekundach symulowanych)
+typedef long sim_time_t;
+
+// Funkcja obsługi zdarzenia
+typedef void (*DesHandler)(void* arg);
+
+// Zdarzenie w kolejce priorytetowej
+typedef struct {
+    sim_time_t time;     // Czas zajścia zdarzenia
+    unsigned long seq;   // Numer kolejny (stała kolejność zdarzeń o tym samym czasie)
+    DesHandler handler;  // Funkcja obsługi zdarzenia
+    void* arg;           // Argument funkcji obsługi
+} DesEvent;
+
+// Silnik symulacji zdarzeń dyskretnych
+typedef struct {
+    DesEvent* heap;          // Kopiec zdarzeń (najwcześniejsze na szczycie)
+    int size;                // Liczba zaplanowanych zdarzeń
+    int capacity;            // Rozmiar zaalokowanego kopca
+    unsigned long next_seq;  // Licznik do rozstrzygania remisów
+    sim_time_t now;          // Wirtualny zegar
+} Des;
+
+// Funkcje silnika
+int des_init(Des* des);
+void des_destroy(Des* des);
+int des_schedule(Des* des, sim_time_t delay, DesHandler handler, void* arg);
+bool des_pop(Des* des, DesEvent* out);
+bool des_step(Des* des);
+void des_run(Des* des);
+
+// Symulacja sezonu w trybie zdarzeń dyskretnych (kończy się wcześniej po wyczerpaniu limitu narciarzy),
+// zwraca liczbę symulowanych dni
+int des_run_season(int days, bool print_days);
+void des_request_stop(void);
+
+#endif
@@ -0,0 +1,20 @@
+#include "futex.h"
+#include <linux/futex.h>
+#include <sys/syscall.h>
+#include <time.h>
+#include <unistd.h>
+
+// Futeks bez FUTEX_PRIVATE_FLAG, więc może go używać kilka procesów
+void futex_wait(atomic_uint* word, unsigned expected) {
+    syscall(SYS_futex, word, FUTEX_WAIT, expected, NULL, NULL, 0);
+}
+
+// Oczekiwanie przerywane po upływie czasu (w milisekundach)
+void futex_wait_timeout(atomic_uint* word, unsigned expected, long timeout_ms) {
+    struct timespec timeout = { timeout_ms / 1000, (timeout_ms % 1000) * 1000000L };
+    syscall(SYS_futex, word, FUTEX_WAIT, expected, &timeout, NULL, 0);
+}
+
+void futex_wake(atomic_uint* word, int count) {
+    syscall(SYS_futex, word, FUTEX_WAKE, count, NULL, NULL, 0);
+}
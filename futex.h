@@ -0,0 +1,11 @@
+#ifndef FUTEX_H
+#define FUTEX_H
+
+#include <stdatomic.h>
+
+// Oczekiwanie na zmianę słowa atomowego; działa także dla słów w pamięci dzielonej między procesami
+void futex_wait(atomic_uint* word, unsigned expected);
+void futex_wait_timeout(atomic_uint* word, unsigned expected, long timeout_ms);
+void futex_wake(atomic_uint* word, int count);
+
+#endif
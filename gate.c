@@ -0,0 +1,233 @@
+#include "gate.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <string.h>
+
+static Gate* gates;      // Bramki wszystkich kolejek (num_gates), kolejno po gates_per_lift
+static int num_gates;
+static int gates_per_lift;
+static GatePolicy gate_policy;
+
+// Inicjalizacja kolejki: numer sekwencyjny komórki wskazuje, czy jest wolna
+static int gate_queue_init(GateQueue* queue, size_t capacity) {
+    queue->cells = malloc(sizeof(GateCell) * capacity);
+    if (!queue->cells) {
+        return -1;
+    }
+    for (size_t i = 0; i < capacity; i++) {
+        atomic_init(&queue->cells[i].sequence, i);
+        queue->cells[i].skier = NULL;
+    }
+    queue->mask = capacity - 1;
+    atomic_init(&queue->enqueue_pos, 0);
+    atomic_init(&queue->dequeue_pos, 0);
+    return 0;
+}
+
+// Dodanie narciarza na koniec kolejki, false gdy kolejka jest pełna
+static bool gate_queue_push(GateQueue* queue, Skier* skier) {
+    size_t pos = atomic_load_explicit(&queue->enqueue_pos, memory_order_relaxed);
+    GateCell* cell;
+    while (true) {
+        cell = &queue->cells[pos & queue->mask];
+        size_t seq = atomic_load_explicit(&cell->sequence, memory_order_acquire);
+        intptr_t diff = (intptr_t)seq - (intptr_t)pos;
+        if (diff == 0) {
+            if (atomic_compare_exchange_weak_explicit(&queue->enqueue_pos, &pos, pos + 1,
+                                                      memory_order_relaxed, memory_order_relaxed)) {
+                break;
+            }
+        } else if (diff < 0) {
+            return false;
+        } else {
+            pos = atomic_load_explicit(&queue->enqueue_pos, memory_order_relaxed);
+        }
+    }
+    cell->skier = skier;
+    atomic_store_explicit(&cell->sequence, pos + 1, memory_order_release);
+    return true;
+}
+
+// Zdjęcie narciarza z początku kolejki, NULL gdy kolejka jest pusta
+static Skier* gate_queue_pop(GateQueue* queue) {
+    size_t pos = atomic_load_explicit(&queue->dequeue_pos, memory_order_relaxed);
+    GateCell* cell;
+    while (true) {
+        cell = &queue->cells[pos & queue->mask];
+        size_t seq = atomic_load_explicit(&cell->sequence, memory_order_acquire);
+        intptr_t diff = (intptr_t)seq - (intptr_t)(pos + 1);
+        if (diff == 0) {
+            if (atomic_compare_exchange_weak_explicit(&queue->dequeue_pos, &pos, pos + 1,
+                                                      memory_order_relaxed, memory_order_relaxed)) {
+                break;
+            }
+        } else if (diff < 0) {
+            return NULL;
+        } else {
+            pos = atomic_load_explicit(&queue->dequeue_pos, memory_order_relaxed);
+        }
+    }
+    Skier* skier = cell->skier;
+    atomic_store_explicit(&cell->sequence, pos + queue->mask + 1, memory_order_release);
+    return skier;
+}
+
+// Przybliżona długość kolejki
+static size_t gate_queue_depth(GateQueue* queue) {
+    size_t tail = atomic_load_explicit(&queue->enqueue_pos, memory_order_relaxed);
+    size_t head = atomic_load_explicit(&queue->dequeue_pos, memory_order_relaxed);
+    return tail > head ? tail - head : 0;
+}
+
+// Inicjalizacja bramek
+int gates_init(GatePolicy policy) {
+    gate_policy = policy;
+    gates_per_lift = config.num_gates;
+    num_gates = config.num_lifts * gates_per_lift;
+    gates = aligned_alloc(CACHE_LINE, sizeof(Gate) * num_gates);
+    if (!gates) {
+        return -1;
+    }
+    memset(gates, 0, sizeof(Gate) * num_gates);
+    for (int i = 0; i < num_gates; i++) {
+        if (gate_queue_init(&gates[i].queue, config.gate_queue_capacity) == -1) {
+            for (int j = 0; j < i; j++) {
+                free(gates[j].queue.cells);
+            }
+            free(gates);
+            gates = NULL;
+            return -1;
+        }
+        gates[i].gate_id = i;
+        atomic_init(&gates[i].busy, false);
+        atomic_init(&gates[i].passes, 0);
+        atomic_init(&gates[i].stolen, 0);
+        atomic_init(&gates[i].max_depth, 0);
+    }
+    return 0;
+}
+
+void gates_destroy(void) {
+    for (int i = 0; i < num_gates; i++) {
+        free(gates[i].queue.cells);
+    }
+    free(gates);
+    gates = NULL;
+    num_gates = 0;
+}
+
+// Wybór bramki kolejki: losowej albo z najkrótszą kolejką (remisy rozstrzyga losowy początek)
+int gate_choose(Rng* rng, int lift_id) {
+    int first = lift_id * gates_per_lift;
+    int start = first + rng_below(rng, gates_per_lift);
+    if (gate_policy == GATE_RANDOM) {
+        return start;
+    }
+
+    int best = start;
+    size_t best_depth = gate_queue_depth(&gates[start].queue);
+    for (int i = 1; i < gates_per_lift && best_depth > 0; i++) {
+        int gate_id = first + (start - first + i) % gates_per_lift;
+        size_t depth = gate_queue_depth(&gates[gate_id].queue);
+        if (depth < best_depth) {
+            best = gate_id;
+            best_depth = depth;
+        }
+    }
+    return best;
+}
+
+// Ustawienie narciarza w kolejce do bramki
+bool gate_enqueue(int gate_id, Skier* skier) {
+    Gate* gate = &gates[gate_id];
+    if (!gate_queue_push(&gate->queue, skier)) {
+        return false;
+    }
+
+    long depth = (long)gate_queue_depth(&gate->queue);
+    long max_depth = atomic_load_explicit(&gate->max_depth, memory_order_relaxed);
+    while (depth > max_depth &&
+           !atomic_compare_exchange_weak_explicit(&gate->max_depth, &max_depth, depth,
+                                                  memory_order_relaxed, memory_order_relaxed)) {
+    }
+    return true;
+}
+
+// Sąsiednia bramka tej samej kolejki z dłuższą kolejką (-1 gdy obie są puste)
+static int longest_neighbour(int gate_id) {
+    int first = gate_id - gate_id % gates_per_lift;
+    int left = first + (gate_id - first + gates_per_lift - 1) % gates_per_lift;
+    int right = first + (gate_id - first + 1) % gates_per_lift;
+    size_t left_depth = left != gate_id ? gate_queue_depth(&gates[left].queue) : 0;
+    size_t right_depth = right != gate_id ? gate_queue_depth(&gates[right].queue) : 0;
+    if (left_depth == 0 && right_depth == 0) {
+        return -1;
+    }
+    return left_depth >= right_depth ? left : right;
+}
+
+// Następny narciarz dla bramki: z własnej kolejki albo przejęty od najdłuższej sąsiedniej
+Skier* gate_take(int gate_id, bool* stolen) {
+    Gate* gate = &gates[gate_id];
+    *stolen = false;
+
+    Skier* skier = gate_queue_pop(&gate->queue);
+    if (!skier) {
+        int neighbour = longest_neighbour(gate_id);
+        if (neighbour >= 0) {
+            skier = gate_queue_pop(&gates[neighbour].queue);
+            *stolen = skier != NULL;
+        }
+    }
+
+    if (skier) {
+        atomic_fetch_add_explicit(&gate->passes, skier->group_size, memory_order_relaxed); // Grupa przechodzi razem
+        if (*stolen) {
+            atomic_fetch_add_explicit(&gate->stolen, 1, memory_order_relaxed);
+        }
+    }
+    return skier;
+}
+
+// Czy bramka ma kogo obsłużyć (u siebie lub u sąsiadów)
+bool gate_has_work(int gate_id) {
+    return gate_queue_depth(&gates[gate_id].queue) > 0 || longest_neighbour(gate_id) >= 0;
+}
+
+size_t gate_depth(int gate_id) {
+    return gate_queue_depth(&gates[gate_id].queue);
+}
+
+// Oznaczenie bramki jako obsługującej, true jeśli była bezczynna
+bool gate_try_activate(int gate_id) {
+    bool expected = false;
+    return atomic_compare_exchange_strong(&gates[gate_id].busy, &expected, true);
+}
+
+// Zwolnienie bramki; bariera gwarantuje, że ponowne sprawdzenie kolejki zobaczy nowych narciarzy
+void gate_deactivate(int gate_id) {
+    atomic_store(&gates[gate_id].busy, false);
+    atomic_thread_fence(memory_order_seq_cst);
+}
+
+// Liczba narciarzy przepuszczonych przez wszystkie bramki
+long gates_total_passes(void) {
+    long passes = 0;
+    for (int i = 0; i < num_gates; i++) {
+        passes += atomic_load(&gates[i].passes);
+    }
+    return passes;
+}
+
+// Raport przepustowości i długości kolejek bramek
+void gates_print_report(double hours) {
+    printf("\n[Raport bramek]\n");
+    for (int i = 0; i < num_gates; i++) {
+        Gate* gate = &gates[i];
+        long passes = atomic_load(&gate->passes);
+        printf("- Bramka #%d (kolejka #%d): przejscia %ld (%.0f/h), przejete od sasiadow %ld, najdluzsza kolejka %ld, obecnie %zu.\n",
+               i, i / gates_per_lift, passes, hours > 0 ? passes / hours : 0.0, atomic_load(&gate->stolen),
+               atomic_load(&gate->max_depth), gate_queue_depth(&gate->queue));
+    }
+}
@@ -0,0 +1,54 @@
+#ifndef GATE_H
+#define GATE_H
+
+#include <stdatomic.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include "station.h"
+
+#define CACHE_LINE 64
+
+// Sposób wyboru bramki przez narciarza
+typedef enum {
+    GATE_RANDOM,         // Losowa bramka
+    GATE_SHORTEST_QUEUE  // Bramka z najkrótszą kolejką
+} GatePolicy;
+
+// Komórka ograniczonej kolejki MPMC
+typedef struct {
+    atomic_size_t sequence;
+    Skier* skier;
+} GateCell;
+
+// Ograniczona kolejka MPMC bez blokad (wielu producentów, wielu konsumentów)
+typedef struct {
+    GateCell* cells;
+    size_t mask;
+    _Alignas(CACHE_LINE) atomic_size_t enqueue_pos;
+    _Alignas(CACHE_LINE) atomic_size_t dequeue_pos;
+} GateQueue;
+
+// Bramka z własną kolejką i licznikami, każda na osobnych liniach pamięci podręcznej
+typedef struct {
+    _Alignas(CACHE_LINE) GateQueue queue;
+    _Alignas(CACHE_LINE) atomic_bool busy; // Czy zadanie bramki jest zaplanowane
+    atomic_long passes;                    // Liczba przepuszczonych narciarzy
+    atomic_long stolen;                    // Narciarze przejęci z kolejek sąsiednich bramek
+    atomic_long max_depth;                 // Najdłuższa zaobserwowana kolejka
+    int gate_id;
+} Gate;
+
+// Funkcje bramek
+int gates_init(GatePolicy policy);
+void gates_destroy(void);
+int gate_choose(Rng* rng, int lift_id);
+bool gate_enqueue(int gate_id, Skier* skier);
+Skier* gate_take(int gate_id, bool* stolen);
+bool gate_has_work(int gate_id);
+size_t gate_depth(int gate_id);
+bool gate_try_activate(int gate_id);
+void gate_deactivate(int gate_id);
+long gates_total_passes(void);
+void gates_print_report(double hours);
+
+#endif
@@ -0,0 +1,151 @@
+#include "hist.h"
+#include <pthread.h>
+#include <stdatomic.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+// Histogramy jednego wątku: zapisuje tylko właściciel, odczyt scala wszystkie wątki
+typedef struct HistThread {
+    atomic_uint_least64_t counts[HIST_COUNT][HIST_BUCKETS];
+    atomic_uint_least64_t sum[HIST_COUNT];
+    atomic_uint_least64_t max[HIST_COUNT];
+    struct HistThread* next;  // Lista histogramów wszystkich wątków
+} HistThread;
+
+static const char* stage_names[HIST_COUNT] = {
+    [HIST_GATE_WAIT]      = "Kolejka do bramki",
+    [HIST_PLATFORM_WAIT]  = "Wejscie na peron",
+    [HIST_CHAIR_WAIT]     = "Krzeselko (zwykli)",
+    [HIST_CHAIR_WAIT_VIP] = "Krzeselko (VIP)",
+    [HIST_TOTAL_WAIT]     = "Lacznie do krzeselka",
+    [HIST_LIFT_STOP]      = "Zatrzymanie kolejki",
+    [HIST_DESCENT]        = "Zjazd trasa",
+};
+
+static pthread_mutex_t threads_mutex = PTHREAD_MUTEX_INITIALIZER;
+static HistThread* threads = NULL;
+static __thread HistThread* thread_hist = NULL;
+
+// Numer przedziału dla wartości
+static int bucket_of(uint64_t value) {
+    if (value < HIST_SUB_COUNT) {
+        return (int)value;
+    }
+    int magnitude = 63 - __builtin_clzll(value);
+    int shift = magnitude - HIST_SUB_BITS;
+    return (shift + 1) * HIST_SUB_COUNT + (int)((value >> shift) - HIST_SUB_COUNT);
+}
+
+// Największa wartość należąca do przedziału
+static uint64_t bucket_max(int bucket) {
+    if (bucket < HIST_SUB_COUNT) {
+        return (uint64_t)bucket;
+    }
+    int shift = bucket / HIST_SUB_COUNT - 1;
+    uint64_t low = (uint64_t)(HIST_SUB_COUNT + bucket % HIST_SUB_COUNT) << shift;
+    return low + ((1ULL << shift) - 1);
+}
+
+// Histogramy bieżącego wątku, tworzone przy pierwszym pomiarze
+static HistThread* get_thread_hist(void) {
+    if (thread_hist) {
+        return thread_hist;
+    }
+    HistThread* hist = calloc(1, sizeof(HistThread));
+    if (!hist) {
+        return NULL;
+    }
+    pthread_mutex_lock(&threads_mutex);
+    hist->next = threads;
+    threads = hist;
+    pthread_mutex_unlock(&threads_mutex);
+    thread_hist = hist;
+    return hist;
+}
+
+// Zapis pomiaru: bez blokad i bez operacji read-modify-write, jedynym piszącym jest wątek
+void hist_record(HistStage stage, sim_time_t value) {
+    HistThread* hist = get_thread_hist();
+    if (!hist) {
+        return;
+    }
+    uint64_t v = value > 0 ? (uint64_t)value : 0;
+    atomic_uint_least64_t* count = &hist->counts[stage][bucket_of(v)];
+    atomic_store_explicit(count, atomic_load_explicit(count, memory_order_relaxed) + 1, memory_order_relaxed);
+    atomic_store_explicit(&hist->sum[stage], atomic_load_explicit(&hist->sum[stage], memory_order_relaxed) + v,
+                          memory_order_relaxed);
+    if (v > atomic_load_explicit(&hist->max[stage], memory_order_relaxed)) {
+        atomic_store_explicit(&hist->max[stage], v, memory_order_relaxed);
+    }
+}
+
+// Scalenie histogramów etapu ze wszystkich wątków
+void hist_snapshot(HistStage stage, Histogram* out) {
+    memset(out, 0, sizeof(*out));
+    pthread_mutex_lock(&threads_mutex);
+    for (HistThread* hist = threads; hist; hist = hist->next) {
+        for (int i = 0; i < HIST_BUCKETS; i++) {
+            uint64_t count = atomic_load_explicit(&hist->counts[stage][i], memory_order_relaxed);
+            out->counts[i] += count;
+            out->total += count;
+        }
+        out->sum += atomic_load_explicit(&hist->sum[stage], memory_order_relaxed);
+        uint64_t max = atomic_load_explicit(&hist->max[stage], memory_order_relaxed);
+        if (max > out->max) {
+            out->max = max;
+        }
+    }
+    pthread_mutex_unlock(&threads_mutex);
+}
+
+// Wartość, poniżej której leży podany procent pomiarów
+sim_time_t hist_percentile(const Histogram* hist, double percentile) {
+    if (hist->total == 0) {
+        return 0;
+    }
+    uint64_t rank = (uint64_t)(percentile / 100.0 * hist->total + 0.5);
+    if (rank < 1) {
+        rank = 1;
+    }
+    uint64_t seen = 0;
+    for (int i = 0; i < HIST_BUCKETS; i++) {
+        seen += hist->counts[i];
+        if (seen >= rank) {
+            uint64_t value = bucket_max(i);
+            return (sim_time_t)(value < hist->max ? value : hist->max);
+        }
+    }
+    return (sim_time_t)hist->max;
+}
+
+// Raport czasów oczekiwania na wszystkich etapach
+void hist_print_report(void) {
+    static Histogram hist; // Duża struktura, raport wypisuje jeden wątek naraz
+    static pthread_mutex_t report_mutex = PTHREAD_MUTEX_INITIALIZER;
+
+    pthread_mutex_lock(&report_mutex);
+    printf("\n[Raport czasow oczekiwania (sekundy symulowane)]\n");
+    printf("%-22s %8s %8s %6s %6s %6s %6s\n", "Etap", "Pomiary", "Srednia", "p50", "p95", "p99", "Max");
+    for (int stage = 0; stage < HIST_COUNT; stage++) {
+        hist_snapshot((HistStage)stage, &hist);
+        double mean = hist.total ? (double)hist.sum / hist.total : 0.0;
+        printf("%-22s %8llu %8.1f %6ld %6ld %6ld %6llu\n", stage_names[stage], (unsigned long long)hist.total, mean,
+               hist_percentile(&hist, 50), hist_percentile(&hist, 95), hist_percentile(&hist, 99),
+               (unsigned long long)hist.max);
+    }
+    fflush(stdout);
+    pthread_mutex_unlock(&report_mutex);
+}
+
+// Zwolnienie histogramów wszystkich wątków
+void hist_destroy(void) {
+    pthread_mutex_lock(&threads_mutex);
+    while (threads) {
+        HistThread* next = threads->next;
+        free(threads);
+        threads = next;
+    }
+    pthread_mutex_unlock(&threads_mutex);
+    thread_hist = NULL;
+}
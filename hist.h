@@ -0,0 +1,40 @@
+#ifndef HIST_H
+#define HIST_H
+
+#include <stdint.h>
+#include "des.h"
+
+// Histogram logarytmiczno-liniowy (jak HDR): 2^HIST_SUB_BITS przedziałów na każdą potęgę dwójki,
+// błąd względny wartości nie przekracza 1/2^HIST_SUB_BITS
+#define HIST_SUB_BITS 4
+#define HIST_SUB_COUNT (1 << HIST_SUB_BITS)
+#define HIST_BUCKETS ((64 - HIST_SUB_BITS) * HIST_SUB_COUNT)
+
+// Mierzone etapy oczekiwania (w sekundach symulowanych)
+typedef enum {
+    HIST_GATE_WAIT,      // Od ustawienia się w kolejce do przejścia przez bramkę
+    HIST_PLATFORM_WAIT,  // Od bramki do wejścia na peron
+    HIST_CHAIR_WAIT,     // Na peronie do wejścia na krzesełko (zwykli narciarze)
+    HIST_CHAIR_WAIT_VIP, // Na peronie do wejścia na krzesełko (VIP)
+    HIST_TOTAL_WAIT,     // Od ustawienia się w kolejce do bramki do wejścia na krzesełko
+    HIST_LIFT_STOP,      // Czas zatrzymania kolejki przez pracownika
+    HIST_DESCENT,        // Zjazd trasą (zależny od zatłoczenia)
+    HIST_COUNT
+} HistStage;
+
+// Scalony histogram jednego etapu
+typedef struct {
+    uint64_t counts[HIST_BUCKETS];
+    uint64_t total;   // Liczba pomiarów
+    uint64_t sum;     // Suma wartości
+    uint64_t max;     // Największa wartość
+} Histogram;
+
+// Funkcje histogramów
+void hist_record(HistStage stage, sim_time_t value);
+void hist_snapshot(HistStage stage, Histogram* out);
+sim_time_t hist_percentile(const Histogram* hist, double percentile);
+void hist_print_report(void);
+void hist_destroy(void);
+
+#endif
@@ -0,0 +1,140 @@
+#include "ledger.h"
+#include "lockstat.h"
+#include <fcntl.h>
+#include <pthread.h>
+#include <stdio.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <unistd.h>
+
+#define LEDGER_CHUNK_BYTES ((off_t)LEDGER_CHUNK * (off_t)sizeof(LedgerRecord))
+
+_Static_assert(sizeof(LedgerRecord) == 64, "Rekord ksiegi musi zajmowac jedna linie pamieci podrecznej");
+_Static_assert(sizeof(LedgerHeader) <= LEDGER_HEADER_SIZE, "Naglowek ksiegi jest za duzy");
+
+static int ledger_fd = -1;
+static LedgerHeader* header = NULL;
+static LedgerRecord* chunks[LEDGER_MAX_CHUNKS];  // Odwzorowania kolejnych przyrostów pliku
+static atomic_int mapped_chunks;
+static pthread_mutex_t grow_mutex = PTHREAD_MUTEX_INITIALIZER;
+
+// Powiększenie pliku i odwzorowanie kolejnych przyrostów aż do podanego włącznie
+static int ledger_grow(int chunk) {
+    LOCK_MUTEX(&grow_mutex, LOCK_LEDGER_GROW, 0);
+    int mapped = atomic_load_explicit(&mapped_chunks, memory_order_relaxed);
+    while (mapped <= chunk) {
+        off_t offset = LEDGER_HEADER_SIZE + mapped * LEDGER_CHUNK_BYTES;
+        if (ftruncate(ledger_fd, offset + LEDGER_CHUNK_BYTES) == -1) {
+            break;
+        }
+        void* area = mmap(NULL, LEDGER_CHUNK_BYTES, PROT_READ | PROT_WRITE, MAP_SHARED, ledger_fd, offset);
+        if (area == MAP_FAILED) {
+            break;
+        }
+        chunks[mapped] = area;
+        mapped++;
+        atomic_store_explicit(&header->capacity, (long long)mapped * LEDGER_CHUNK, memory_order_release);
+        atomic_store_explicit(&mapped_chunks, mapped, memory_order_release);
+    }
+    pthread_mutex_unlock(&grow_mutex);
+    return mapped > chunk ? 0 : -1;
+}
+
+// Utworzenie pustej księgi w pliku
+int ledger_open(const char* path) {
+    ledger_fd = open(path, O_RDWR | O_CREAT | O_TRUNC, 0644);
+    if (ledger_fd == -1) {
+        return -1;
+    }
+    if (ftruncate(ledger_fd, LEDGER_HEADER_SIZE) == -1) {
+        close(ledger_fd);
+        return -1;
+    }
+    header = mmap(NULL, LEDGER_HEADER_SIZE, PROT_READ | PROT_WRITE, MAP_SHARED, ledger_fd, 0);
+    if (header == MAP_FAILED) {
+        header = NULL;
+        close(ledger_fd);
+        return -1;
+    }
+
+    memcpy(header->magic, LEDGER_MAGIC, sizeof(header->magic));
+    header->version = 1;
+    header->record_size = sizeof(LedgerRecord);
+    atomic_init(&header->capacity, 0);
+    atomic_init(&header->count, 0);
+    atomic_init(&mapped_chunks, 0);
+    return ledger_grow(0);
+}
+
+// Odłączenie księgi; plik zostaje na dysku
+void ledger_close(void) {
+    int mapped = atomic_load(&mapped_chunks);
+    for (int i = 0; i < mapped; i++) {
+        munmap(chunks[i], LEDGER_CHUNK_BYTES);
+        chunks[i] = NULL;
+    }
+    atomic_store(&mapped_chunks, 0);
+    if (header) {
+        munmap(header, LEDGER_HEADER_SIZE);
+        header = NULL;
+    }
+    if (ledger_fd != -1) {
+        close(ledger_fd);
+        ledger_fd = -1;
+    }
+}
+
+// Rekord narciarza, w razie potrzeby po powiększeniu pliku (NULL po przekroczeniu limitu)
+LedgerRecord* ledger_record(int skier_id) {
+    if (skier_id < 0) {
+        return NULL;
+    }
+    int chunk = skier_id / LEDGER_CHUNK;
+    if (chunk >= LEDGER_MAX_CHUNKS) {
+        return NULL;
+    }
+    if (chunk >= atomic_load_explicit(&mapped_chunks, memory_order_acquire) && ledger_grow(chunk) == -1) {
+        return NULL;
+    }
+    return &chunks[chunk][skier_id % LEDGER_CHUNK];
+}
+
+// Rejestracja narciarza po zakupie biletu
+void ledger_register(int skier_id, int ticket_type, bool is_vip) {
+    LedgerRecord* record = ledger_record(skier_id);
+    if (!record) {
+        fprintf(stderr, "Blad: Brak miejsca w ksiedze dla narciarza #%d.\n", skier_id);
+        return;
+    }
+    record->skier_id = skier_id;
+    record->ticket_type = (int8_t)ticket_type;
+    record->is_vip = is_vip;
+    record->is_used = 1;
+
+    long long count = atomic_load_explicit(&header->count, memory_order_relaxed);
+    while (skier_id + 1 > count &&
+           !atomic_compare_exchange_weak_explicit(&header->count, &count, skier_id + 1,
+                                                  memory_order_release, memory_order_relaxed)) {
+    }
+}
+
+// Doliczenie czasu oczekiwania na bramkę, peron i krzesełko
+void ledger_add_wait(int skier_id, sim_time_t wait) {
+    LedgerRecord* record = ledger_record(skier_id);
+    if (record) {
+        atomic_fetch_add_explicit(&record->wait_time, wait, memory_order_relaxed);
+    }
+}
+
+// Zapis zjazdu wybraną trasą
+void ledger_add_ride(int skier_id, int track) {
+    LedgerRecord* record = ledger_record(skier_id);
+    if (record) {
+        atomic_fetch_add_explicit(&record->rides, 1, memory_order_relaxed);
+        atomic_fetch_add_explicit(&record->track_rides[track], 1, memory_order_relaxed);
+    }
+}
+
+int ledger_count(void) {
+    return header ? (int)atomic_load(&header->count) : 0;
+}
@@ -0,0 +1,47 @@
+#ifndef LEDGER_H
+#define LEDGER_H
+
+#include <stdatomic.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include "des.h"
+
+// Układ pliku księgi (może go odwzorować tylko do odczytu zewnętrzny proces):
+//   [LedgerHeader, dopełniony do LEDGER_HEADER_SIZE][rekord 0][rekord 1]...
+// Plik rośnie o LEDGER_CHUNK rekordów; zapisane rekordy nigdy nie zmieniają położenia.
+#define LEDGER_MAGIC "SKILEDG1"
+#define LEDGER_HEADER_SIZE 4096
+#define LEDGER_CHUNK 4096        // Rekordów w jednym przyroście pliku
+#define LEDGER_MAX_CHUNKS 4096   // Maksymalnie LEDGER_CHUNK * LEDGER_MAX_CHUNKS narciarzy
+#define LEDGER_TRACKS 3
+
+// Nagłówek księgi
+typedef struct {
+    char magic[8];
+    uint32_t version;
+    uint32_t record_size;
+    atomic_llong capacity;    // Liczba rekordów, na które jest miejsce w pliku
+    atomic_llong count;       // Najwyższe zarejestrowane ID narciarza + 1
+} LedgerHeader;
+
+// Rekord narciarza zajmujący dokładnie jedną linię pamięci podręcznej
+typedef struct {
+    _Alignas(64) int32_t skier_id;
+    int8_t ticket_type;                    // 0-2: Tk1-Tk3, 3: bilet dzienny
+    int8_t is_vip;
+    int8_t is_used;                        // Czy rekord należy do zarejestrowanego narciarza
+    atomic_int rides;                      // Liczba zjazdów
+    atomic_int track_rides[LEDGER_TRACKS]; // Zjazdy poszczególnymi trasami
+    atomic_llong wait_time;                // Łączny czas oczekiwania (w sekundach symulowanych)
+} LedgerRecord;
+
+// Funkcje księgi przejazdów
+int ledger_open(const char* path);
+void ledger_close(void);
+LedgerRecord* ledger_record(int skier_id);
+void ledger_register(int skier_id, int ticket_type, bool is_vip);
+void ledger_add_wait(int skier_id, sim_time_t wait);
+void ledger_add_ride(int skier_id, int track);
+int ledger_count(void);
+
+#endif
@@ -0,0 +1,98 @@
+#include "lift.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+// Inicjalizacja pustego pierścienia krzesełek o rozmiarze z konfiguracji
+int lift_init(ChairLift* lift) {
+    memset(lift, 0, sizeof(ChairLift));
+    lift->num_chairs = config.max_chairs;
+    lift->seats_per_chair = config.max_people_on_chair;
+    lift->chairs = calloc(lift->num_chairs, sizeof(Chair));
+    lift->seats = calloc((size_t)lift->num_chairs * lift->seats_per_chair, sizeof(Skier*));
+    if (!lift->chairs || !lift->seats) {
+        lift_destroy(lift);
+        return -1;
+    }
+    for (int i = 0; i < lift->num_chairs; i++) {
+        lift->chairs[i].riders = &lift->seats[i * lift->seats_per_chair];
+    }
+    return 0;
+}
+
+void lift_destroy(ChairLift* lift) {
+    free(lift->chairs);
+    free(lift->seats);
+    lift->chairs = NULL;
+    lift->seats = NULL;
+}
+
+// Krzesełko na górnej stacji znajduje się pół pierścienia za punktem załadunku
+static Chair* top_chair(ChairLift* lift) {
+    return &lift->chairs[(lift->loading_chair + lift->num_chairs / 2) % lift->num_chairs];
+}
+
+// Zejście wszystkich pasażerów krzesełka na górnej stacji, zwraca ich liczbę
+int lift_unload(ChairLift* lift, Skier** out) {
+    Chair* chair = top_chair(lift);
+    int count = chair->occupied;
+    memcpy(out, chair->riders, sizeof(Skier*) * count);
+    chair->occupied = 0;
+    return count;
+}
+
+// Wejście grupy narciarzy na krzesełko w punkcie załadunku jedną operacją
+int lift_board(ChairLift* lift, Skier** skiers, int count) {
+    Chair* chair = &lift->chairs[lift->loading_chair];
+    int free_seats = lift->seats_per_chair - chair->occupied;
+    if (count > free_seats) {
+        count = free_seats;
+    }
+    memcpy(&chair->riders[chair->occupied], skiers, sizeof(Skier*) * count);
+    chair->occupied += count;
+    chair->carried += count;
+    lift->carried += count;
+    return count;
+}
+
+// Odjazd krzesełka z punktu załadunku i podjazd kolejnego
+void lift_advance(ChairLift* lift) {
+    lift->chairs[lift->loading_chair].departures++;
+    lift->departures++;
+    lift->running_time += CHAIR_INTERVAL;
+    lift->loading_chair = (lift->loading_chair + 1) % lift->num_chairs;
+}
+
+// Liczba narciarzy jadących krzesełkami
+int lift_riders(const ChairLift* lift) {
+    int riders = 0;
+    for (int i = 0; i < lift->num_chairs; i++) {
+        riders += lift->chairs[i].occupied;
+    }
+    return riders;
+}
+
+// Raport zapełnienia krzesełek i przepustowości
+void lift_print_report(const ChairLift* lift, int lift_id) {
+    printf("\n[Raport kolejki linowej #%d]\n", lift_id);
+    if (lift->departures == 0) {
+        printf("- Kolejka nie wykonala zadnego kursu.\n");
+        return;
+    }
+
+    double hours = lift->running_time / 3600.0;
+    printf("- Odjazdy krzeselek: %ld, przewiezieni narciarze: %ld.\n", lift->departures, lift->carried);
+    printf("- Srednie zapelnienie krzeselka: %.2f / %d.\n",
+           (double)lift->carried / lift->departures, lift->seats_per_chair);
+    printf("- Przepustowosc: %.0f miejsc/h (maksymalnie %d miejsc/h).\n",
+           lift->carried / hours, lift->seats_per_chair * 3600 / CHAIR_INTERVAL);
+    printf("- Zapelnienie poszczegolnych krzeselek:");
+    for (int i = 0; i < lift->num_chairs; i++) {
+        const Chair* chair = &lift->chairs[i];
+        if (i % 10 == 0) {
+            printf("\n ");
+        }
+        printf(" #%-2d %.2f", i, chair->departures ? (double)chair->carried / chair->departures : 0.0);
+    }
+    printf("\n");
+}
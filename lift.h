@@ -0,0 +1,39 @@
+#ifndef LIFT_H
+#define LIFT_H
+
+#include "station.h"
+
+// Odstęp między krzesełkami w punkcie załadunku (w sekundach symulowanych).
+// Połowa pierścienia jedzie w górę, więc krzesełko dociera na górę po czasie ride_time.
+#define CHAIR_INTERVAL (config.ride_time * config.sim_seconds_per_step / (config.max_chairs / 2))
+
+// Krzesełko na linie
+typedef struct {
+    Skier** riders;                     // Pasażerowie (max_people_on_chair miejsc)
+    int occupied;                       // Liczba zajętych miejsc
+    long departures;                    // Liczba przejść przez punkt załadunku
+    long carried;                       // Liczba przewiezionych narciarzy
+} Chair;
+
+// Pierścień krzesełek przesuwający się o jedno miejsce co CHAIR_INTERVAL
+typedef struct {
+    Chair* chairs;            // Krzesełka (max_chairs)
+    Skier** seats;            // Miejsca wszystkich krzesełek w jednym bloku
+    int num_chairs;
+    int seats_per_chair;
+    int loading_chair;        // Indeks krzesełka w punkcie załadunku
+    long departures;          // Liczba wszystkich przejść przez punkt załadunku
+    long carried;             // Liczba wszystkich przewiezionych narciarzy
+    long running_time;        // Czas pracy kolejki (w sekundach symulowanych)
+} ChairLift;
+
+// Funkcje kolejki krzesełkowej (wywołujący zapewnia wzajemne wykluczanie)
+int lift_init(ChairLift* lift);
+void lift_destroy(ChairLift* lift);
+int lift_unload(ChairLift* lift, Skier** out);
+int lift_board(ChairLift* lift, Skier** skiers, int count);
+void lift_advance(ChairLift* lift);
+int lift_riders(const ChairLift* lift);
+void lift_print_report(const ChairLift* lift, int lift_id);
+
+#endif
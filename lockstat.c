@@ -0,0 +1,256 @@
+#include "lockstat.h"
+
+#ifdef LOCK_STATS
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+// Liczniki jednego prymitywu w jednym wątku
+typedef struct {
+    atomic_uint_least64_t acquisitions;  // Zajęcia mutexu albo wywołania oczekiwania
+    atomic_uint_least64_t contended;     // Z tego zakończone zablokowaniem wątku
+    atomic_uint_least64_t wait_ns;       // Łączny czas zablokowania
+    atomic_uint_least64_t max_ns;        // Najdłuższe zablokowanie
+} LockCounters;
+
+// Liczniki jednego wątku: zapisuje tylko właściciel, raport scala wszystkie wątki (jak w hist.c)
+typedef struct LockThread {
+    LockCounters counters[LOCK_SITES][LOCKSTAT_INSTANCES];
+    struct LockThread* next;
+} LockThread;
+
+static const char* site_names[LOCK_SITES] = {
+    [LOCK_STATION]        = "Mutex stacji",
+    [LOCK_STATION_CLOSED] = "Zamkniecie stacji (cond)",
+    [LOCK_SHARD]          = "Mutex kolejki",
+    [LOCK_LIFT_STATE]     = "Stan kolejki (futeks)",
+    [LOCK_POOL]           = "Mutex zadan puli",
+    [LOCK_POOL_IDLE]      = "Bezczynnosc puli (cond)",
+    [LOCK_TIMER]          = "Mutex zadan odroczonych",
+    [LOCK_TIMER_IDLE]     = "Termin zadan odrocz. (cond)",
+    [LOCK_SLOPE]          = "Mutex tras",
+    [LOCK_ARENA]          = "Mutex areny",
+    [LOCK_LOG_RINGS]      = "Mutex buforow dziennika",
+    [LOCK_LOG_WRITE]      = "Mutex zapisu dziennika",
+    [LOCK_LEDGER_GROW]    = "Mutex powiekszania ksiegi",
+    [LOCK_TRACE_GROW]     = "Mutex powiekszania sladu",
+    [LOCK_REGISTRY_GROW]  = "Mutex rejestru biletow",
+    [LOCK_RING]           = "Pierscien procesow (futeks)",
+};
+
+// Prymitywy, na których wątki czekają na zdarzenie, a nie na zwolnienie blokady
+static const bool site_is_wait[LOCK_SITES] = {
+    [LOCK_STATION_CLOSED] = true,
+    [LOCK_LIFT_STATE]     = true,
+    [LOCK_POOL_IDLE]      = true,
+    [LOCK_TIMER_IDLE]     = true,
+    [LOCK_RING]           = true,
+};
+
+// Prymitywy z osobnym egzemplarzem dla każdej kolejki
+static const bool site_per_lift[LOCK_SITES] = {
+    [LOCK_SHARD]      = true,
+    [LOCK_LIFT_STATE] = true,
+};
+
+static pthread_mutex_t threads_mutex = PTHREAD_MUTEX_INITIALIZER;
+static LockThread* threads = NULL;
+static __thread LockThread* thread_stats = NULL;
+
+// Wątki zablokowane teraz i najwięcej naraz (zmieniane tylko przy zablokowaniu)
+static atomic_int waiting[LOCK_SITES][LOCKSTAT_INSTANCES];
+static atomic_int max_waiting[LOCK_SITES][LOCKSTAT_INSTANCES];
+
+static uint64_t now_ns(void) {
+    struct timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return (uint64_t)now.tv_sec * 1000000000ULL + (uint64_t)now.tv_nsec;
+}
+
+static int slot_of(int instance) {
+    return instance < 0 ? 0 : instance < LOCKSTAT_INSTANCES ? instance : LOCKSTAT_INSTANCES - 1;
+}
+
+// Liczniki bieżącego wątku, tworzone przy pierwszym pomiarze
+static LockCounters* counters_of(LockSite site, int slot) {
+    if (!thread_stats) {
+        LockThread* stats = calloc(1, sizeof(LockThread));
+        if (!stats) {
+            return NULL;
+        }
+        pthread_mutex_lock(&threads_mutex);
+        stats->next = threads;
+        threads = stats;
+        pthread_mutex_unlock(&threads_mutex);
+        thread_stats = stats;
+    }
+    return &thread_stats->counters[site][slot];
+}
+
+static void add(atomic_uint_least64_t* counter, uint64_t value) {
+    atomic_store_explicit(counter, atomic_load_explicit(counter, memory_order_relaxed) + value, memory_order_relaxed);
+}
+
+static void record(LockSite site, int slot, bool contended, uint64_t blocked_ns) {
+    LockCounters* counters = counters_of(site, slot);
+    if (!counters) {
+        return;
+    }
+    add(&counters->acquisitions, 1);
+    if (contended) {
+        add(&counters->contended, 1);
+        add(&counters->wait_ns, blocked_ns);
+        if (blocked_ns > atomic_load_explicit(&counters->max_ns, memory_order_relaxed)) {
+            atomic_store_explicit(&counters->max_ns, blocked_ns, memory_order_relaxed);
+        }
+    }
+}
+
+// Początek zablokowania: licznik czekających i jego najwyższa wartość
+static uint64_t block_begin(LockSite site, int slot) {
+    int now = atomic_fetch_add_explicit(&waiting[site][slot], 1, memory_order_relaxed) + 1;
+    int max = atomic_load_explicit(&max_waiting[site][slot], memory_order_relaxed);
+    while (now > max && !atomic_compare_exchange_weak_explicit(&max_waiting[site][slot], &max, now,
+                                                                memory_order_relaxed, memory_order_relaxed)) {
+    }
+    return now_ns();
+}
+
+static void block_end(LockSite site, int slot, uint64_t started) {
+    uint64_t blocked = now_ns() - started;
+    atomic_fetch_sub_explicit(&waiting[site][slot], 1, memory_order_relaxed);
+    record(site, slot, true, blocked);
+}
+
+// Zajęcie mutexu: najpierw próba bez czekania, zegar tylko przy rywalizacji
+int lockstat_mutex_lock(pthread_mutex_t* mutex, LockSite site, int instance) {
+    int slot = slot_of(instance);
+    if (pthread_mutex_trylock(mutex) == 0) {
+        record(site, slot, false, 0);
+        return 0;
+    }
+    uint64_t started = block_begin(site, slot);
+    int rc = pthread_mutex_lock(mutex);
+    block_end(site, slot, started);
+    return rc;
+}
+
+// Oczekiwanie na zmiennej warunkowej (razem z ponownym zajęciem mutexu)
+int lockstat_cond_wait(pthread_cond_t* cond, pthread_mutex_t* mutex, LockSite site, int instance) {
+    int slot = slot_of(instance);
+    uint64_t started = block_begin(site, slot);
+    int rc = pthread_cond_wait(cond, mutex);
+    block_end(site, slot, started);
+    return rc;
+}
+
+int lockstat_cond_timedwait(pthread_cond_t* cond, pthread_mutex_t* mutex, const struct timespec* deadline,
+                            LockSite site, int instance) {
+    int slot = slot_of(instance);
+    uint64_t started = block_begin(site, slot);
+    int rc = pthread_cond_timedwait(cond, mutex, deadline);
+    block_end(site, slot, started);
+    return rc;
+}
+
+// Oczekiwanie na futeksie; słowo zmienione przed wywołaniem nie blokuje wątku
+void lockstat_futex_wait(atomic_uint* word, unsigned expected, LockSite site, int instance) {
+    int slot = slot_of(instance);
+    if (atomic_load(word) != expected) {
+        record(site, slot, false, 0);
+        return;
+    }
+    uint64_t started = block_begin(site, slot);
+    futex_wait(word, expected);
+    block_end(site, slot, started);
+}
+
+void lockstat_futex_wait_timeout(atomic_uint* word, unsigned expected, long timeout_ms, LockSite site, int instance) {
+    int slot = slot_of(instance);
+    if (atomic_load(word) != expected) {
+        record(site, slot, false, 0);
+        return;
+    }
+    uint64_t started = block_begin(site, slot);
+    futex_wait_timeout(word, expected, timeout_ms);
+    block_end(site, slot, started);
+}
+
+// Raport wszystkich użytych prymitywów i blokady, na której wątki straciły najwięcej czasu
+void lockstat_print_report(void) {
+    static pthread_mutex_t report_mutex = PTHREAD_MUTEX_INITIALIZER;
+
+    pthread_mutex_lock(&report_mutex);
+    printf("\n[Raport rywalizacji o blokady (czas rzeczywisty)]\n");
+    printf("%-28s %10s %11s %6s %11s %9s %9s %6s\n", "Prymityw", "Nabycia", "Z czekaniem", "%", "Lacznie ms",
+           "Sr. us", "Max us", "Max w.");
+    int worst_site = -1;
+    int worst_slot = 0;
+    uint64_t worst_ns = 0;
+    pthread_mutex_lock(&threads_mutex);
+    for (int site = 0; site < LOCK_SITES; site++) {
+        for (int slot = 0; slot < LOCKSTAT_INSTANCES; slot++) {
+            uint64_t acquisitions = 0, contended = 0, wait_ns = 0, max_ns = 0;
+            for (LockThread* stats = threads; stats; stats = stats->next) {
+                LockCounters* counters = &stats->counters[site][slot];
+                acquisitions += atomic_load_explicit(&counters->acquisitions, memory_order_relaxed);
+                contended += atomic_load_explicit(&counters->contended, memory_order_relaxed);
+                wait_ns += atomic_load_explicit(&counters->wait_ns, memory_order_relaxed);
+                uint64_t max = atomic_load_explicit(&counters->max_ns, memory_order_relaxed);
+                if (max > max_ns) {
+                    max_ns = max;
+                }
+            }
+            if (acquisitions == 0) {
+                continue;
+            }
+            char name[40];
+            if (site_per_lift[site]) {
+                snprintf(name, sizeof(name), "%s #%d%s", site_names[site], slot,
+                         slot == LOCKSTAT_INSTANCES - 1 ? "+" : "");
+            } else {
+                snprintf(name, sizeof(name), "%s", site_names[site]);
+            }
+            printf("%-28s %10llu %11llu %5.1f%% %11.1f %9.1f %9.1f %6d\n", name, (unsigned long long)acquisitions,
+                   (unsigned long long)contended, 100.0 * contended / acquisitions, wait_ns / 1e6,
+                   contended ? wait_ns / 1e3 / contended : 0.0, max_ns / 1e3,
+                   atomic_load_explicit(&max_waiting[site][slot], memory_order_relaxed));
+            if (!site_is_wait[site] && wait_ns > worst_ns) {
+                worst_site = site;
+                worst_slot = slot;
+                worst_ns = wait_ns;
+            }
+        }
+    }
+    pthread_mutex_unlock(&threads_mutex);
+    if (worst_site >= 0) {
+        printf("Najdluzsze czekanie na blokade: %s", site_names[worst_site]);
+        if (site_per_lift[worst_site]) {
+            printf(" #%d", worst_slot);
+        }
+        printf(" (%.1f ms).\n", worst_ns / 1e6);
+    } else {
+        printf("Zadna blokada nie zatrzymala watku.\n");
+    }
+    printf("(Oczekiwania na zdarzenie - cond i futeks - to czas bezczynnosci, nie rywalizacji.)\n");
+    fflush(stdout);
+    pthread_mutex_unlock(&report_mutex);
+}
+
+// Zwolnienie liczników wszystkich wątków
+void lockstat_destroy(void) {
+    pthread_mutex_lock(&threads_mutex);
+    while (threads) {
+        LockThread* next = threads->next;
+        free(threads);
+        threads = next;
+    }
+    pthread_mutex_unlock(&threads_mutex);
+    thread_stats = NULL;
+    memset(max_waiting, 0, sizeof(max_waiting));
+}
+
+#endif
@@ -0,0 +1,65 @@
+#ifndef LOCKSTAT_H
+#define LOCKSTAT_H
+
+#include <pthread.h>
+#include <stdatomic.h>
+#include <time.h>
+#include "futex.h"
+
+// Pomiar rywalizacji o prymitywy synchronizacji, włączany przy kompilacji (-DLOCK_STATS);
+// bez tej flagi makra rozwijają się do zwykłych wywołań i nie kosztują nic
+#define LOCKSTAT_INSTANCES 16   // Egzemplarze jednego prymitywu (np. kolejki); dalsze liczone razem z ostatnim
+
+// Instrumentowane prymitywy
+typedef enum {
+    LOCK_STATION,         // station_mutex: otwarcie stacji i liczba aktywnych narciarzy
+    LOCK_STATION_CLOSED,  // station_closed_cond: oczekiwanie na zamknięcie stacji
+    LOCK_SHARD,           // Mutex kolejki: peron, planista wsiadania i krzesełka
+    LOCK_LIFT_STATE,      // Futeks słowa stanu kolejki (pracownicy czekający na zatrzymanie/wznowienie)
+    LOCK_POOL,            // Kolejka zadań puli wątków
+    LOCK_POOL_IDLE,       // Wątki puli czekające na zadanie
+    LOCK_TIMER,           // Zadania odroczone puli
+    LOCK_TIMER_IDLE,      // Wątek zadań odroczonych czekający na termin albo nowe zadanie
+    LOCK_SLOPE,           // Trasy
+    LOCK_ARENA,           // Wspólna lista wolnych rekordów narciarzy
+    LOCK_LOG_RINGS,       // Lista buforów dziennika (rejestracja wątku i zbieranie rekordów)
+    LOCK_LOG_WRITE,       // Wypisywanie partii dziennika
+    LOCK_LEDGER_GROW,     // Powiększanie księgi przejazdów
+    LOCK_TRACE_GROW,      // Powiększanie śladu zdarzeń
+    LOCK_REGISTRY_GROW,   // Tworzenie fragmentów rejestru biletów
+    LOCK_RING,            // Futeks pierścienia komunikatów (tryb wieloprocesowy, tylko proces stacji)
+    LOCK_SITES
+} LockSite;
+
+#ifdef LOCK_STATS
+
+int lockstat_mutex_lock(pthread_mutex_t* mutex, LockSite site, int instance);
+int lockstat_cond_wait(pthread_cond_t* cond, pthread_mutex_t* mutex, LockSite site, int instance);
+int lockstat_cond_timedwait(pthread_cond_t* cond, pthread_mutex_t* mutex, const struct timespec* deadline,
+                            LockSite site, int instance);
+void lockstat_futex_wait(atomic_uint* word, unsigned expected, LockSite site, int instance);
+void lockstat_futex_wait_timeout(atomic_uint* word, unsigned expected, long timeout_ms, LockSite site, int instance);
+void lockstat_print_report(void);
+void lockstat_destroy(void);
+
+#define LOCK_MUTEX(mutex, site, instance) lockstat_mutex_lock((mutex), (site), (instance))
+#define WAIT_COND(cond, mutex, site, instance) lockstat_cond_wait((cond), (mutex), (site), (instance))
+#define WAIT_COND_UNTIL(cond, mutex, deadline, site, instance) \
+    lockstat_cond_timedwait((cond), (mutex), (deadline), (site), (instance))
+#define WAIT_FUTEX(word, expected, site, instance) lockstat_futex_wait((word), (expected), (site), (instance))
+#define WAIT_FUTEX_FOR(word, expected, timeout_ms, site, instance) \
+    lockstat_futex_wait_timeout((word), (expected), (timeout_ms), (site), (instance))
+
+#else
+
+#define LOCK_MUTEX(mutex, site, instance) pthread_mutex_lock(mutex)
+#define WAIT_COND(cond, mutex, site, instance) pthread_cond_wait((cond), (mutex))
+#define WAIT_COND_UNTIL(cond, mutex, deadline, site, instance) pthread_cond_timedwait((cond), (mutex), (deadline))
+#define WAIT_FUTEX(word, expected, site, instance) futex_wait((word), (expected))
+#define WAIT_FUTEX_FOR(word, expected, timeout_ms, site, instance) futex_wait_timeout((word), (expected), (timeout_ms))
+#define lockstat_print_report() ((void)0)
+#define lockstat_destroy() ((void)0)
+
+#endif
+
+#endif
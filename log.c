@@ -0,0 +1,271 @@
+#include "log.h"
+#include "config.h"
+#include "lockstat.h"
+#include <stdatomic.h>
+#include <stdbool.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <pthread.h>
+#include <sched.h>
+#include <time.h>
+
+#define LOG_RING_CAPACITY 4096  // Rekordów w buforze jednego wątku (potęga dwójki)
+#define LOG_BATCH 8192          // Rekordów formatowanych jednym przebiegiem
+#define LOG_IDLE_NS 1000000     // Przerwa wątku dziennika, gdy nie ma nic do zapisania
+
+// Opis zdarzenia: poziom, kolor ANSI i treść
+typedef struct {
+    LogLevel level;
+    const char* color;
+    const char* format;
+} LogEventInfo;
+
+static const LogEventInfo event_info[EV_COUNT] = {
+    [EV_GATE_ENTER]      = { LOG_DEBUG, "\033[42m", "Narciarz #%d wchodzi przez bramke #%d." },
+    [EV_GATES_FULL]      = { LOG_WARN,  "\033[33m", "Narciarz #%d: wszystkie kolejki do bramek kolejki #%d sa pelne, wroci za chwile." },
+    [EV_GATE_STEAL]      = { LOG_DEBUG, "\033[34m", "[Bramka #%d] Przejmuje narciarza #%d z kolejki sasiedniej bramki." },
+    [EV_GATE_PASS]       = { LOG_DEBUG, "\033[34m", "[Bramka #%d] Narciarz #%d przechodzi przez bramke na dolny peron." },
+    [EV_GATE_CLOSED]     = { LOG_DEBUG, NULL,       "Narciarz #%d nie moze wejsc na platforme, stacja jest zamknieta." },
+    [EV_TICKET_REJECTED] = { LOG_WARN,  "\033[31m", "[Bramka #%d] Odrzuca niewazny bilet narciarza #%d." },
+    [EV_PLATFORM_ENTER]  = { LOG_DEBUG, "\033[42m", "Narciarz #%d wchodzi na platforme." },
+    [EV_WAIT_RESUME]     = { LOG_DEBUG, NULL,       "Narciarz #%d czeka na wznowienie kolejki." },
+    [EV_WAIT_CHAIR]      = { LOG_DEBUG, NULL,       "Narciarz #%d czeka na krzeselko." },
+    [EV_BOARD]           = { LOG_DEBUG, "\033[42m", "Narciarz #%d wsiada na krzeselko." },
+    [EV_BOARD_VIP]       = { LOG_DEBUG, "\033[36m", "Narciarz VIP #%d ma pierwszenstwo i wsiada na krzeselko." },
+    [EV_GROUP_BOARD]     = { LOG_DEBUG, "\033[42m", "Grupa narciarza #%d (%d osoby) zajmuje razem jedno krzeselko." },
+    [EV_RIDE_STOPPED]    = { LOG_DEBUG, NULL,       "Narciarz #%d zatrzymuje sie na krzeselku i czeka na wznowienie." },
+    [EV_ALIGHT]          = { LOG_DEBUG, NULL,       "Narciarz #%d konczy jazde krzeselkiem i schodzi z platformy." },
+    [EV_TRACK]           = { LOG_DEBUG, NULL,       "Narciarz #%d zjezdza trasa T%d." },
+    [EV_SKIER_DONE]      = { LOG_DEBUG, NULL,       "Narciarz #%d konczy dzien na stacji." },
+    [EV_SKIER_LOST]      = { LOG_ERROR, "\033[41m", "Brak pamieci dla narciarza #%d, nie wchodzi na stacje." },
+    [EV_NO_GUARDIAN]     = { LOG_WARN,  NULL,       "Narciarz #%d to dziecko, ktore nie ma opiekuna i nie moze korzystac z kolejki." },
+    [EV_GUARDIAN_FULL]   = { LOG_WARN,  NULL,       "Narciarz #%d nie moze wejsc na kolejke, bo jego opiekun ma juz pod opieka maksymalna liczbe dzieci." },
+    [EV_DISCOUNT]        = { LOG_DEBUG, "\033[33m", "Narciarz #%d otrzymal znizke na karnet." },
+    [EV_HOUR]            = { LOG_INFO,  NULL,       "Symulowany czas: %d h." },
+    [EV_STATION_CLOSING] = { LOG_INFO,  "\033[31m", "Stacja zamyka sie." },
+    [EV_LIFT_STOP]       = { LOG_INFO,  "\033[43m", "Kolejka linowa #%d zostala zatrzymana przez pracownika #%d." },
+    [EV_LIFT_RESUME]     = { LOG_INFO,  "\033[43m", "Kolejka linowa #%d zostala wznowiona przez pracownika #%d." },
+    [EV_WORKER_REQUEST]  = { LOG_INFO,  "\033[33m", "Pracownik #%d wysyla zapytanie do pracownika #%d o gotowosc." },
+    [EV_WORKER_RECEIVED] = { LOG_INFO,  "\033[33m", "Pracownik #%d otrzymal komunikat: Pracownik #%d zatrzymuje kolejke." },
+    [EV_WORKER_REPLY]    = { LOG_INFO,  "\033[33m", "Pracownik #%d otrzymal odpowiedz: Pracownik #%d gotowy do wznowienia." },
+    [EV_WORKER_DONE]     = { LOG_INFO,  "\033[33m", "[Pracownik #%d] Konczy prace." },
+    [EV_RESPONDER_DONE]  = { LOG_INFO,  NULL,       "[Pracownik #%d] Konczy prace na podstawie sygnalu zakonczenia." },
+    [EV_LIFT_DRAINING]   = { LOG_INFO,  NULL,       "Ostatni narciarz opuscil peron kolejki #%d. Kolejka jedzie do oproznienia krzeselek." },
+    [EV_LIFT_SHUTDOWN]   = { LOG_INFO,  "\033[41m", "Kolejka #%d zostala zatrzymana." },
+};
+
+// Bufor cykliczny jednego wątku: jeden producent (wątek), jeden konsument (wątek dziennika)
+typedef struct LogRing {
+    LogRecord records[LOG_RING_CAPACITY];
+    _Alignas(64) atomic_size_t head;  // Następny rekord do odczytu
+    _Alignas(64) atomic_size_t tail;  // Następne wolne miejsce
+    struct LogRing* next;             // Lista wszystkich buforów
+} LogRing;
+
+static volatile LogLevel log_level = LOG_OFF;
+static LogFormat log_format = LOG_COLOR;
+static sim_time_t (*log_clock)(void) = NULL;
+
+static pthread_mutex_t rings_mutex = PTHREAD_MUTEX_INITIALIZER;
+static LogRing* rings = NULL;
+static __thread LogRing* thread_ring = NULL;
+
+static pthread_mutex_t write_mutex = PTHREAD_MUTEX_INITIALIZER; // Zbieranie i wypisywanie partii
+static pthread_t log_thread_id;
+static bool log_thread_started = false;
+static atomic_bool log_running;
+static LogRecord batch[LOG_BATCH];
+
+static uint64_t wall_clock_ns(void) {
+    struct timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return (uint64_t)now.tv_sec * 1000000000ULL + (uint64_t)now.tv_nsec;
+}
+
+// Bufor bieżącego wątku, tworzony przy pierwszym zdarzeniu
+static LogRing* get_thread_ring(void) {
+    if (thread_ring) {
+        return thread_ring;
+    }
+    LogRing* ring = calloc(1, sizeof(LogRing));
+    if (!ring) {
+        return NULL;
+    }
+    LOCK_MUTEX(&rings_mutex, LOCK_LOG_RINGS, 0);
+    ring->next = rings;
+    rings = ring;
+    pthread_mutex_unlock(&rings_mutex);
+    thread_ring = ring;
+    return ring;
+}
+
+// Zapis zdarzenia: bez blokad, tylko kopiowanie rekordu do bufora wątku
+void log_event(LogEventType type, int a, int b) {
+    if (event_info[type].level > log_level) {
+        return;
+    }
+    LogRing* ring = get_thread_ring();
+    if (!ring) {
+        return;
+    }
+
+    size_t tail = atomic_load_explicit(&ring->tail, memory_order_relaxed);
+    // Pełny bufor: czekamy, aż wątek dziennika zrobi miejsce (żaden rekord nie ginie)
+    while (tail - atomic_load_explicit(&ring->head, memory_order_acquire) >= LOG_RING_CAPACITY) {
+        sched_yield();
+    }
+
+    LogRecord* record = &ring->records[tail & (LOG_RING_CAPACITY - 1)];
+    record->wall_ns = wall_clock_ns();
+    record->sim_time = log_clock ? log_clock() : 0;
+    record->type = (uint16_t)type;
+    record->a = a;
+    record->b = b;
+    atomic_store_explicit(&ring->tail, tail + 1, memory_order_release);
+}
+
+static int compare_records(const void* x, const void* y) {
+    const LogRecord* a = x;
+    const LogRecord* b = y;
+    return (a->wall_ns > b->wall_ns) - (a->wall_ns < b->wall_ns);
+}
+
+// Sformatowanie i wypisanie jednego rekordu
+static void write_record(const LogRecord* record) {
+    const LogEventInfo* info = &event_info[record->type];
+    if (log_format == LOG_PLAIN) {
+        printf("[%02ld:%02ld:%02ld] ", config.opening_hour + record->sim_time / 3600, (record->sim_time / 60) % 60, record->sim_time % 60);
+        printf(info->format, record->a, record->b);
+        putchar('\n');
+        return;
+    }
+    if (info->color) {
+        fputs(info->color, stdout);
+    }
+    printf(info->format, record->a, record->b);
+    fputs(info->color ? "\033[0m\n" : "\n", stdout);
+}
+
+// Zebranie rekordów ze wszystkich buforów, zwraca ich liczbę
+static int collect_batch(void) {
+    int count = 0;
+    LOCK_MUTEX(&rings_mutex, LOCK_LOG_RINGS, 0);
+    for (LogRing* ring = rings; ring && count < LOG_BATCH; ring = ring->next) {
+        size_t head = atomic_load_explicit(&ring->head, memory_order_relaxed);
+        size_t tail = atomic_load_explicit(&ring->tail, memory_order_acquire);
+        while (head != tail && count < LOG_BATCH) {
+            batch[count++] = ring->records[head & (LOG_RING_CAPACITY - 1)];
+            head++;
+        }
+        atomic_store_explicit(&ring->head, head, memory_order_release);
+    }
+    pthread_mutex_unlock(&rings_mutex);
+    return count;
+}
+
+// Wątek dziennika: formatuje rekordy w kolejności czasu i opróżnia stdout
+static void* log_thread(void* arg) {
+    (void)arg;
+    while (true) {
+        LOCK_MUTEX(&write_mutex, LOCK_LOG_WRITE, 0);
+        int count = collect_batch();
+        if (count > 0) {
+            qsort(batch, count, sizeof(LogRecord), compare_records);
+            for (int i = 0; i < count; i++) {
+                write_record(&batch[i]);
+            }
+            fflush(stdout);
+        }
+        pthread_mutex_unlock(&write_mutex);
+
+        if (count == 0) {
+            if (!atomic_load(&log_running)) {
+                break;
+            }
+            struct timespec idle = { 0, LOG_IDLE_NS };
+            nanosleep(&idle, NULL);
+        }
+    }
+    return NULL;
+}
+
+// Uruchomienie dziennika
+int log_init(LogLevel level, LogFormat format) {
+    log_level = level;
+    log_format = format;
+    atomic_store(&log_running, true);
+    if (pthread_create(&log_thread_id, NULL, log_thread, NULL) != 0) {
+        return -1;
+    }
+    log_thread_started = true;
+    return 0;
+}
+
+void log_set_level(LogLevel level) {
+    log_level = level;
+}
+
+void log_set_clock(sim_time_t (*clock)(void)) {
+    log_clock = clock;
+}
+
+// Poziom na podstawie nazwy z linii poleceń
+int log_parse_level(const char* name, LogLevel* level) {
+    static const char* names[] = { "off", "error", "warn", "info", "debug" };
+    for (int i = 0; i <= LOG_DEBUG; i++) {
+        if (strcmp(name, names[i]) == 0) {
+            *level = (LogLevel)i;
+            return 0;
+        }
+    }
+    return -1;
+}
+
+// Oczekiwanie, aż wszystkie zapisane rekordy trafią na wyjście
+void log_flush(void) {
+    if (!log_thread_started) {
+        return;
+    }
+    while (true) {
+        bool empty = true;
+        LOCK_MUTEX(&rings_mutex, LOCK_LOG_RINGS, 0);
+        for (LogRing* ring = rings; ring; ring = ring->next) {
+            if (atomic_load(&ring->head) != atomic_load(&ring->tail)) {
+                empty = false;
+                break;
+            }
+        }
+        pthread_mutex_unlock(&rings_mutex);
+        if (empty) {
+            break;
+        }
+        struct timespec idle = { 0, LOG_IDLE_NS };
+        nanosleep(&idle, NULL);
+    }
+
+    // Bufory są puste; czekamy jeszcze na wypisanie ostatniej zebranej partii
+    LOCK_MUTEX(&write_mutex, LOCK_LOG_WRITE, 0);
+    fflush(stdout);
+    pthread_mutex_unlock(&write_mutex);
+}
+
+// Zatrzymanie wątku dziennika po wypisaniu wszystkich rekordów
+void log_shutdown(void) {
+    if (!log_thread_started) {
+        return;
+    }
+    atomic_store(&log_running, false);
+    pthread_join(log_thread_id, NULL);
+    log_level = LOG_OFF;
+    log_thread_started = false;
+
+    LOCK_MUTEX(&rings_mutex, LOCK_LOG_RINGS, 0);
+    while (rings) {
+        LogRing* next = rings->next;
+        free(rings);
+        rings = next;
+    }
+    pthread_mutex_unlock(&rings_mutex);
+    thread_ring = NULL;
+}
@@ -0,0 +1,76 @@
+#ifndef LOG_H
+#define LOG_H
+
+#include <stdint.h>
+#include "des.h"
+
+// Poziomy komunikatów (LOG_OFF wyłącza dziennik całkowicie, np. w testach wydajności)
+typedef enum {
+    LOG_OFF,
+    LOG_ERROR,  // Narciarz utracony z powodu błędu (brak pamięci)
+    LOG_WARN,   // Narciarz odrzucony albo odesłany (bilet, opiekun, pełne kolejki do bramek)
+    LOG_INFO,   // Zdarzenia stacji (zegar, kolejka, pracownicy)
+    LOG_DEBUG   // Kroki poszczególnych narciarzy
+} LogLevel;
+
+// Format wyjścia
+typedef enum {
+    LOG_COLOR,  // Kolory ANSI jak w trybie interaktywnym
+    LOG_PLAIN   // Czysty tekst z czasem symulowanym, łatwy do przetwarzania
+} LogFormat;
+
+// Typy zdarzeń zapisywanych w dzienniku
+typedef enum {
+    EV_GATE_ENTER,
+    EV_GATES_FULL,
+    EV_GATE_STEAL,
+    EV_GATE_PASS,
+    EV_GATE_CLOSED,
+    EV_TICKET_REJECTED,
+    EV_PLATFORM_ENTER,
+    EV_WAIT_RESUME,
+    EV_WAIT_CHAIR,
+    EV_BOARD,
+    EV_BOARD_VIP,
+    EV_GROUP_BOARD,
+    EV_RIDE_STOPPED,
+    EV_ALIGHT,
+    EV_TRACK,
+    EV_SKIER_DONE,
+    EV_SKIER_LOST,
+    EV_NO_GUARDIAN,
+    EV_GUARDIAN_FULL,
+    EV_DISCOUNT,
+    EV_HOUR,
+    EV_STATION_CLOSING,
+    EV_LIFT_STOP,
+    EV_LIFT_RESUME,
+    EV_WORKER_REQUEST,
+    EV_WORKER_RECEIVED,
+    EV_WORKER_REPLY,
+    EV_WORKER_DONE,
+    EV_RESPONDER_DONE,
+    EV_LIFT_DRAINING,
+    EV_LIFT_SHUTDOWN,
+    EV_COUNT
+} LogEventType;
+
+// Binarny rekord zdarzenia
+typedef struct {
+    uint64_t wall_ns;     // Czas rzeczywisty (porządkowanie rekordów z różnych wątków)
+    sim_time_t sim_time;  // Czas symulowany
+    uint16_t type;        // LogEventType
+    int32_t a;            // Argumenty komunikatu
+    int32_t b;
+} LogRecord;
+
+// Funkcje dziennika
+int log_init(LogLevel level, LogFormat format);
+void log_set_level(LogLevel level);
+void log_set_clock(sim_time_t (*clock)(void));
+int log_parse_level(const char* name, LogLevel* level);
+void log_event(LogEventType type, int a, int b);
+void log_flush(void);
+void log_shutdown(void);
+
+#endif
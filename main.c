@@ -1,52 +1,66 @@
 #include <stdio.h>
+#include <errno.h>
 #include <string.h>
 #include <stdlib.h>
 #include <pthread.h>
-#include <semaphore.h>
 #include <stdbool.h>
 #include <unistd.h>
 #include <time.h>
 #include <sys/ipc.h>
-#include <sys/shm.h>
 #include <sys/msg.h>
 #include <signal.h>
+#include <poll.h>
+#include <stdatomic.h>
+#include <sys/eventfd.h>
+#include <sys/signalfd.h>
 #include "ticket.h"
-
-#define MAX_CHAIRS 40         // Liczba krzesełek
-#define MAX_PEOPLE_ON_CHAIR 3 // Liczba miejsc na jednym krzesełku
-#define MAX_PEOPLE_ON_PLATFORM 50 // Maksymalna liczba osób na peronie
-#define SIMULATION_STEP 1 // 1 sekunda = 1 minuta w symulacji
-
-// Dodanie tras
-#define T1_TIME 2  // Czas przejazdu trasy T1 (w sekundach)
-#define T2_TIME 4  // Czas przejazdu trasy T2 (w sekundach)
-#define T3_TIME 6  // Czas przejazdu trasy T3 (w sekundach)
-#define NUM_GATES 4 // Liczba bramek
-
-// Symulowany czas
-volatile int simulated_time = 0; 
-volatile bool is_station_open = true;
-volatile bool is_lift_running = true;
-volatile int skiers_on_platform = 0;
-volatile int skiers_in_lift_queue = 0;
-
-// Semafory
-sem_t platform_sem;
-sem_t chairlift_sem;
-sem_t vip_chairlift_sem; // Semafor dla osób VIP
-sem_t gates[NUM_GATES]; // Semafory dla bramek
-sem_t gate_ready[NUM_GATES]; // Semafory wskazujące, że bramka jest gotowa
-
-
-// Mutexy i zmienne warunkowe
-pthread_mutex_t lift_mutex = PTHREAD_MUTEX_INITIALIZER;
-pthread_mutex_t station_mutex = PTHREAD_MUTEX_INITIALIZER;
-pthread_cond_t lift_condition = PTHREAD_COND_INITIALIZER;
-pthread_mutex_t lift_operation_mutex = PTHREAD_MUTEX_INITIALIZER;
+#include "station.h"
+#include "des.h"
+#include "pool.h"
+#include "log.h"
+#include "ledger.h"
+#include "hist.h"
+#include "procs.h"
+#include "slope.h"
+#include "trace.h"
+#include "usage.h"
+#include "arrivals.h"
+#include "monitor.h"
+#include "lockstat.h"
+
+#define DEFAULT_LEDGER_PATH "ski_station.ledger" // Domyślny plik księgi przejazdów
 
 // Watki
-pthread_t worker_thread_id,responder_thread_id, time_thread, lift_shutdown,skier_thread_id;
-pthread_t gate_threads[NUM_GATES];
+pthread_t signal_thread_id;
+pthread_t* worker_thread_ids;     // Pracownik każdej kolejki
+pthread_t* responder_thread_ids;  // Drugi pracownik każdej kolejki
+int worker_pairs = 0;             // Liczba uruchomionych par pracowników
+
+// Deskryptory wątku sygnałów: SIGUSR2, SIGINT i SIGTERM oraz żądanie zakończenia wątku
+int signal_fd = -1;
+int signal_stop_fd = -1;
+
+// Etapy zamykania stacji, każdy rozpoczynany przez faktyczny stan poprzedniego
+typedef enum {
+    DRAIN_CLOSED,     // Bramki zamknięte
+    DRAIN_PLATFORMS,  // Perony wszystkich kolejek puste
+    DRAIN_CHAIRS,     // Krzesełka puste, kolejki zatrzymane
+    DRAIN_SKIERS,     // Wszyscy narciarze zakończyli dzień (także zjazdy)
+    DRAIN_WORKERS,    // Pracownicy zakończyli pracę
+    DRAIN_POOL,       // Pula wątków i dziennik zatrzymane
+    DRAIN_PHASES
+} DrainPhase;
+
+static const char* drain_phase_names[DRAIN_PHASES] = {
+    "Zamkniecie bramek", "Puste perony", "Puste krzeselka", "Koniec zjazdow", "Koniec pracy pracownikow",
+    "Zatrzymanie puli watkow",
+};
+
+struct timespec drain_at[DRAIN_PHASES];  // Chwile zakończenia etapów (CLOCK_MONOTONIC)
+struct timespec interrupt_at;            // Chwila odebrania SIGINT/SIGTERM
+long long ipc_release_ns;                // Czas zwolnienia zasobów IPC
+atomic_bool interrupted;                 // Czy odebrano sygnał przerwania
+atomic_bool station_running;             // Czy stacja została otwarta (tryb wątków lub procesów)
 
 // Struktura komunikatu
 typedef struct {
@@ -54,299 +68,126 @@ typedef struct {
     char message_text[100]; // Treść komunikatu
 } Message;
 
-// Struktura narciarza
-typedef struct {
-    int skier_id;       // ID narciarza
-    int age;            // Wiek
-    bool is_vip;        // Czy VIP
-    bool is_guardian;   // Czy opiekun
-    bool has_guardian;  //Czy ma opiekuna?
-    int other_guarded_children_count; // Liczba dzieci pod opieką
-    Ticket* ticket;     // Wskaźnik na bilet
-    bool is_child;      // Czy narciarz jest dzieckiem
-} Skier;
-
-// Wskaźnik do pamięci dzielonej
-int* shared_usage;
-int shm_id; // Globalna zmienna dla ID pamięci dzielonej
-
 // ID kolejki komunikatów
 int msgid;
 
-// Funkcja zatrzymująca kolejkę linową
-void stop_lift(int worker_id) {
+// Pracownicy jako osobne procesy (--procs) albo symulacja zdarzeń dyskretnych (--des)
+bool procs_mode = false;
+bool des_mode = false;
 
-    pthread_mutex_lock(&lift_mutex);
-    if (is_lift_running) {
-        is_lift_running = false;
-        printf("\033[43mKolejka linowa zostala zatrzymana przez pracownika #%d.\033[0m\n",worker_id);
-        pthread_cond_broadcast(&lift_condition); // Powiadomienie wszystkich o zatrzymaniu
-    }
-    pthread_mutex_unlock(&lift_mutex);
+static long long elapsed_ns(const struct timespec* from, const struct timespec* to) {
+    return (to->tv_sec - from->tv_sec) * 1000000000LL + (to->tv_nsec - from->tv_nsec);
 }
-// Funkcja wznawiając kolejkę linową
-void resume_lift(int worker_id) {
-
-    pthread_mutex_lock(&lift_mutex);
-    if (!is_lift_running) {
-        is_lift_running = true;
-        printf("\033[43mKolejka linowa zostala wznowiona przez pracownika #%d.\033[0m\n", worker_id);
-        pthread_cond_broadcast(&lift_condition); // Powiadomienie wszystkich o wznowieniu
-    }
-    pthread_mutex_unlock(&lift_mutex);
+
+static void drain_mark(DrainPhase phase) {
+    clock_gettime(CLOCK_MONOTONIC, &drain_at[phase]);
 }
 
-// Wątek bramki
-void* gate_thread(void* arg) {
+//Wątek pracownika kolejki; typy komunikatów pary to numery jej pracowników
+void* worker_thread(void* arg) {
 
-    int gate_id = *(int*)arg;
+    int lift_id = *(int*)arg;
     free(arg);
+    int worker_id = LIFT_WORKER_ID(lift_id);
+    int responder_id = LIFT_RESPONDER_ID(lift_id);
+    Rng rng;
+    rng_init(&rng, RNG_STREAM_WORKER + worker_id);
 
-    while (true) {
-
-        sem_wait(&gates[gate_id]); // Oczekiwanie na narciarza przy bramce
-        pthread_mutex_lock(&station_mutex);
-        if (!is_station_open) {
-            pthread_mutex_unlock(&station_mutex);
-            break;
-        }
-        pthread_mutex_unlock(&station_mutex);
+    // Pracownik obsługuje kolejkę aż do jej opróżnienia po zamknięciu stacji
+    while (!(lift_state(lift_id) & LIFT_DRAINED)) {
+        if (rng_below(&rng, 10) == 0) { // 10% szans na zatrzymanie kolejki
 
-        printf("\033[34m[Bramka #%d] Narciarz przechodzi przez bramke na dolny peron.\n\033[0m", gate_id);
-        sem_post(&gate_ready[gate_id]);
-	sem_post(&platform_sem); // Zwiększenie liczby osób na peronie
-    }
+            Message msg;
+            msg.message_type = worker_id; // Prośba o gotowość
+            snprintf(msg.message_text, sizeof(msg.message_text), "\033[33mPracownik #%d zatrzymuje kolejke.\033[0m", worker_id);
 
-    printf("\033[34m[Bramka #%d] Zakonczyla prace.\n\033[0m", gate_id);
-    return NULL;
-}
+            stop_lift(lift_id, worker_id);
 
-// Symulacja czasu
-void* time_simulation_thread(void* arg) {
+            log_event(EV_WORKER_REQUEST, worker_id, responder_id);
+            msgsnd(msgid, &msg, sizeof(msg), 0);
 
-    int simulation_duration = (CLOSING_HOUR - OPENING_HOUR) * 60;
+            msgrcv(msgid, &msg, sizeof(msg), responder_id, 0); // Czekaj na odpowiedz od drugiego pracownika
+            log_event(EV_WORKER_REPLY, worker_id, responder_id);
 
-    while (simulated_time < simulation_duration) {
-        sleep(SIMULATION_STEP);
-        simulated_time += 2; // 1 sekunda = 2 minuty
-        if (simulated_time % 60 == 0) {
-            printf("Symulowany czas: %d h.\n", simulated_time / 60);
+            resume_lift(lift_id, worker_id);
         }
+        lift_wait_state_for(lift_id, lift_state(lift_id), 1000); // Czas pracy pracownika, przerywany zmianą stanu kolejki
     }
 
-    pthread_mutex_lock(&station_mutex);
-    is_station_open = false;
-    pthread_mutex_unlock(&station_mutex);
-
-    printf("\033[31mStacja zamyka sie.\n\033[0m");
-    sleep(5);  // Czas na wylaczenie kolejki
-
+    log_event(EV_WORKER_DONE, worker_id, 0);
     return NULL;
 }
 
-// Funkcja obslugi dzieci i opiekunów
-bool can_ski(Skier* skier) {
-
-    if (skier->is_child) {
-        if (!skier->has_guardian) {
-            printf("Narciarz #%d to dziecko, ktore nie ma opiekuna i nie może korzystać z kolejki.\n", skier->skier_id);
-            return false;
-        } else if (skier->other_guarded_children_count >= 2){ // Sprawdzanie liczby dzieci pod opieka
-            printf("Narciarz #%d nie moze wejsc na kolejke, bo jego opiekun ma juz pod opieka maksymalna liczbe dzieci,\n",skier->skier_id);
-         return false;
-        }
+// Oczekiwanie na flagę stanu kolejki; ruch liny zgłasza zmianę na futeksie, bez cyklicznego sprawdzania
+static void wait_lift_flag(int lift_id, unsigned flag) {
+    unsigned state = lift_state(lift_id);
+    while (!(state & flag)) {
+        lift_wait_state(lift_id, state);
+        state = lift_state(lift_id);
     }
-    return true;
 }
 
-// Funkcja wątku narciarza
-void* skier_thread(void* arg) {
+// Zamykanie stacji: zamknięte bramki, pusty peron, puste krzesełka i zatrzymanie każdej kolejki,
+// a na końcu powrót narciarzy z tras; każdy etap zaczyna się, gdy stan stacji na to pozwala
+void drain_station(void) {
+    station_wait_closing();
+    drain_mark(DRAIN_CLOSED);
 
-    Skier* skier = (Skier*)arg;
-
-    if (!can_ski(skier)) {
-        free(skier->ticket);
-        free(skier);
-        return NULL;
+    for (int lift_id = 0; lift_id < config.num_lifts; lift_id++) {
+        wait_lift_flag(lift_id, LIFT_PLATFORM_EMPTY);
+        log_event(EV_LIFT_DRAINING, lift_id, 0);
     }
+    drain_mark(DRAIN_PLATFORMS);
 
-    while (simulated_time < skier->ticket->expiry_time && is_station_open) {
-       if (!is_station_open) break;
-
-	// Oczekiwanie na miejsce na platformie
-	 int gate_id = rand() % NUM_GATES;
-	 printf("\033[42mNarciarz #%d wchodzi przez bramke #%d.\033[0m\n", skier->skier_id, gate_id);
-        sem_post(&gates[gate_id]); // Wysłanie narciarza do bramki
-	 sem_wait(&gate_ready[gate_id]);
-        pthread_mutex_lock(&station_mutex);
-
-        if (!is_station_open) {
-            printf("Narciarz #%d nie moze wejsc na platformee, stacja jest zamknieta.\n", skier->skier_id);
-            pthread_mutex_unlock(&station_mutex);
-            break;
-        }
-
-        pthread_mutex_unlock(&station_mutex);
- 	 sem_wait(&platform_sem);   // Oczekiwanie na wejście na platformę
-
-        __sync_add_and_fetch(&skiers_on_platform, 1); // Zwiększenie liczby narciarzy na platformie
-        printf("\033[42mNarciarz #%d wchodzi na platforme.\033[0m\n", skier->skier_id);
-
-        pthread_mutex_lock(&lift_mutex);
-        while (!is_lift_running) { // Czekaj na wznowienie kolejki
-            printf("Narciarz #%d czeka na wznowienie kolejki.\n", skier->skier_id);
-            pthread_cond_wait(&lift_condition, &lift_mutex);
-        }
-        pthread_mutex_unlock(&lift_mutex);
-
-
-	// VIP ma pierwszenstwo
-        if (skier->ticket->is_vip) {
-            printf("\033[36mNarciarz VIP #%d ma pierwszenstwo i wsiada na krzeselko.\n\033[0m", skier->skier_id);
-            sem_wait(&vip_chairlift_sem); // VIP korzysta z dedykowanego semafora
-        } else {
-            printf("Narciarz #%d czeka na krzeselko.\n", skier->skier_id);
-            sem_wait(&chairlift_sem); // Osoby bez VIP czekaja w zwyklej kolejce
-        }
-
-        // Narciarz wsiada na krzeselko
-
-        __sync_add_and_fetch(&skiers_in_lift_queue, 1); // Zwiekszenie liczby narciarzy w kolejce
-        pthread_mutex_lock(&lift_operation_mutex);
-
-        while (!is_lift_running) {
-            printf("Narciarz #%d czeka na wznowienie kolejki przed wsiadaniem.\n", skier->skier_id);
-            pthread_cond_wait(&lift_condition, &lift_operation_mutex);
-        }
-
-	if(!skier->ticket->is_vip){
-        printf("\033[42mNarciarz #%d wsiada na krzeselko.\033[0m\n", skier->skier_id);
-       }
-	pthread_mutex_unlock(&lift_operation_mutex);
-
-        // Symulacja jazdy
-	int ride_time = 5;  
-	for (int t = 0; t < ride_time; t++) {
-
-            pthread_mutex_lock(&lift_operation_mutex);
-            while (!is_lift_running) {
-                printf("Narciarz #%d zatrzymuje sie na krzeselku i czeka na wznowienie.\n", skier->skier_id);
-                pthread_cond_wait(&lift_condition, &lift_operation_mutex);
-            }
-            pthread_mutex_unlock(&lift_operation_mutex);
-            sleep(1);
-        }
-
-        // Narciarz konczy jazdę
-        pthread_mutex_lock(&lift_operation_mutex);
-
-        while (!is_lift_running) {
-            printf("Narciarz #%d czeka na wznowienie kolejki przed zejsciem.\n", skier->skier_id);
-            pthread_cond_wait(&lift_condition, &lift_operation_mutex);
-        }
-
-        printf("Narciarz #%d konczy jazde krzeselkiem i schodzi z platformy.\n", skier->skier_id);
-        pthread_mutex_unlock(&lift_operation_mutex);
-
-        skier->ticket->usage_count++;
-
-        // Zapis zjazdu w pamięci dzielonej
-        shared_usage[skier->skier_id]++;
-        sem_post(&chairlift_sem); // Zwolnienie miejsca na krzesełku
-        sem_post(&platform_sem);  // Zwolnienie miejsca na platformie
-
-        __sync_sub_and_fetch(&skiers_on_platform, 1); // Zmniejszenie liczby narciarzy na platformie
-        __sync_sub_and_fetch(&skiers_in_lift_queue, 1); // Zmniejszenie liczby narciarzy w kolejce
-
-        // Wybor trasy i czas przejazdu
-        int track_choice = rand() % 3;  // Wybor trasy
-        if (track_choice == 0) {
-            sleep(T1_TIME);
-            printf("Narciarz #%d zjezdza trasa T1.\n", skier->skier_id);
-        } else if (track_choice == 1) {
-            sleep(T2_TIME);
-            printf("Narciarz #%d zjezdza trasa T2.\n", skier->skier_id);
-        } else {
-            sleep(T3_TIME);
-            printf("Narciarz #%d zjezdza trasa T3.\n", skier->skier_id);
-        }
+    for (int lift_id = 0; lift_id < config.num_lifts; lift_id++) {
+        wait_lift_flag(lift_id, LIFT_DRAINED);
+        lift_halt(lift_id);
+        log_event(EV_LIFT_SHUTDOWN, lift_id, 0);
     }
+    drain_mark(DRAIN_CHAIRS);
 
-    printf("Narciarz #%d konczy dzien na stacji.\n", skier->skier_id);
-    free(skier->ticket);
-    free(skier);
-    return NULL;
+    station_wait_closed();
+    drain_mark(DRAIN_SKIERS);
 }
-//Wątek pracownika
-void* worker_thread(void* arg) {
-
-    int worker_id = *(int*)arg;
-    free(arg);
-
-    while (is_station_open) {
-        if (rand() % 10 == 0) { // 10% szans na zatrzymanie kolejki
-
-            Message msg;
-            msg.message_type = 1; // Prośba o gotowość
-            snprintf(msg.message_text, sizeof(msg.message_text), "\033[33mPracownik #%d zatrzymuje kolejke.\033[0m", worker_id);
-
-            stop_lift(worker_id);
-
-            printf("\033[33mPracownik #%d wysyla zapytanie do pracownika #%d o gotowosc.\n\033[0m", worker_id, 2);
-            msgsnd(msgid, &msg, sizeof(msg), 0);
-
-            msgrcv(msgid, &msg, sizeof(msg), 2, 0); // Czekaj na odpowiedz od Pracownika 2
-            printf("\033[33mPracownik #%d otrzymal odpowiedz: %s\n\033[0m", worker_id, msg.message_text);
-
-            resume_lift(worker_id);
-        }
-        sleep(1); // Czas pracy pracownika
 
+// Raport czasu zamykania stacji (czas rzeczywisty od zamknięcia bramek)
+void print_drain_report(void) {
+    printf("\n[Raport zamkniecia stacji]\n");
+    if (atomic_load(&interrupted)) {
+        printf("- Sygnal przerwania -> zamkniecie bramek: %.1f ms.\n",
+               elapsed_ns(&interrupt_at, &drain_at[DRAIN_CLOSED]) / 1e6);
     }
-
-    printf("\033[33m[Pracownik #%d] Konczy prace.\033[0m\n", worker_id);
-    return NULL;
-}
-
-// Zakonczenie pracy kolejki po ostatnim narciarzu
-void* lift_shutdown_thread(void* arg) {
-
-    while (is_station_open || skiers_on_platform > 0 || skiers_in_lift_queue > 0) {
-        sleep(1); // Sprawdzaj co sekunde
+    for (int phase = DRAIN_PLATFORMS; phase < DRAIN_PHASES; phase++) {
+        printf("- %s: +%.1f ms (etap %.1f ms).\n", drain_phase_names[phase],
+               elapsed_ns(&drain_at[DRAIN_CLOSED], &drain_at[phase]) / 1e6,
+               elapsed_ns(&drain_at[phase - 1], &drain_at[phase]) / 1e6);
     }
-
-    printf("Ostatni narciarz opuscil platforme. Kolejka zatrzymuje sie za 5 sekund.\n");
-    sleep(5); // Czas na zatrzymanie kolejki
-
-    pthread_mutex_lock(&lift_mutex);
-    is_lift_running = false;
-    pthread_cond_broadcast(&lift_condition);
-    pthread_mutex_unlock(&lift_mutex);
-
-    printf("\033[41mKolejka zostala zatrzymana.\033[0m\n");
-    return NULL;
+    printf("- Zwolnienie zasobow IPC: %.1f ms.\n", ipc_release_ns / 1e6);
 }
+
 // Wątek pracownika w komunikacji z drugim
 void* responder_thread(void* arg) {
 
-    int worker_id = *(int*)arg;
+    int lift_id = *(int*)arg;
     free(arg);
+    int worker_id = LIFT_RESPONDER_ID(lift_id);
 
-    while (is_station_open) {
+    // Kończy po komunikacie END, wysyłanym po zakończeniu pracy pierwszego pracownika
+    while (true) {
 
         Message msg;
-        msgrcv(msgid, &msg, sizeof(msg), 1, 0);
+        msgrcv(msgid, &msg, sizeof(msg), LIFT_WORKER_ID(lift_id), 0);
 
         // Sprawdz, czy to sygnal zakonczenia
         if (strcmp(msg.message_text, "END") == 0) {
-            printf("[Pracownik #%d] Konczy prace na podstawie sygnalu zakonczenia.\n", worker_id);
+            log_event(EV_RESPONDER_DONE, worker_id, 0);
             break;
         }
 
-        printf("\033[33mPracownik #%d otrzymal komunikat: %s\n\033[0m", worker_id, msg.message_text);
-        sleep(2); // Symulacja sprawdzania gotowosci
+        log_event(EV_WORKER_RECEIVED, worker_id, LIFT_WORKER_ID(lift_id));
+        sleep(config.responder_time); // Symulacja sprawdzania gotowosci
 
-        msg.message_type = 2; // Odpowiedz do Pracownika 1
+        msg.message_type = worker_id; // Odpowiedz do pierwszego pracownika
         snprintf(msg.message_text, sizeof(msg.message_text), "\033[33mPracownik #%d gotowy do wznowienia.\033[0m", worker_id);
         msgsnd(msgid, &msg, sizeof(msg), 0);
     }
@@ -354,147 +195,211 @@ void* responder_thread(void* arg) {
     return NULL;
 }
 
-//Obsługa sygnału SIGUSR2
-void statistic_signal_handler(int signum) {
-	if (signum == SIGUSR2) {
-   	 printf("\n[INFO] Otrzymano sygnał SIGUSR2. Generowanie raportu diagnostycznego...\n");
-   	 printf("[Raport diagnostyczny]\n");
-   	 printf("- Czas symulowany: %d minut.\n", simulated_time);
-   	 printf("- Narciarze na platformie: %d\n", skiers_on_platform);
-   	 printf("- Narciarze w kolejce: %d\n", skiers_in_lift_queue);          
-         }
+// Przerwanie programu: zamknięcie stacji zamiast natychmiastowego wyjścia (wykonywane w wątku sygnałów)
+static void request_shutdown(int signo) {
+    if (atomic_exchange(&interrupted, true)) {
+        return; // Zamykanie już trwa
+    }
+    clock_gettime(CLOCK_MONOTONIC, &interrupt_at);
+    printf("\nOtrzymano sygnał %s. Zamykanie stacji...\n", signo == SIGTERM ? "SIGTERM" : "SIGINT");
+    if (des_mode) {
+        des_request_stop();
+    } else if (atomic_load(&station_running)) {
+        station_close();
+    }
 }
 
-//Zamknięcie używanych mechanizmów i pamięci 
-void cleanup(int signum) {
-
-    printf("\nZatrzymano program. Zwolnienie zasobow...\n");
-pthread_mutex_lock(&station_mutex);
-    is_station_open = false;
-    pthread_mutex_unlock(&station_mutex);
-
+// Raport diagnostyczny na żądanie (SIGUSR2)
+static void print_diagnostic_report(void) {
+    printf("\n[INFO] Otrzymano sygnał SIGUSR2. Generowanie raportu diagnostycznego...\n");
+    printf("[Raport diagnostyczny]\n");
+    printf("- Czas symulowany: %d minut.\n", simulated_time);
+    printf("- Narciarze na platformie: %d\n", station_platform_count());
+    printf("- Narciarze w kolejce: %d\n", station_chair_count());
+    printf("- Narciarze na trasach: %d\n", slopes_skier_count());
+    hist_print_report();
+    usage_print_report(USAGE_TEXT);
+    lockstat_print_report();
+}
 
+// Wątek sygnałów: odbiera SIGUSR2, SIGINT i SIGTERM przez signalfd, więc nic nie dzieje się w funkcji obsługi sygnału
+void* signal_thread(void* arg) {
+    (void)arg;
 
-    // Odblokowanie wszystkich watkow oczekujacych na semafory
-    for (int i = 0; i < NUM_GATES; i++) {
-        sem_post(&gates[i]);
+    struct pollfd fds[2] = {
+        { .fd = signal_fd, .events = POLLIN },
+        { .fd = signal_stop_fd, .events = POLLIN },
+    };
+    while (true) {
+        if (poll(fds, 2, -1) == -1) {
+            continue; // Przerwane wywołanie
+        }
+        if (fds[1].revents & POLLIN) {
+            break;
+        }
+        if (fds[0].revents & POLLIN) {
+            struct signalfd_siginfo info;
+            if (read(signal_fd, &info, sizeof(info)) != sizeof(info)) {
+                continue;
+            }
+            if (info.ssi_signo == SIGUSR2) {
+                print_diagnostic_report();
+            } else {
+                request_shutdown((int)info.ssi_signo);
+            }
+        }
     }
-    pthread_cond_broadcast(&lift_condition);
-
-    // Czekanie na zakończenie pracy głównych wątków
-    pthread_cancel(time_thread);
-    pthread_join(time_thread, NULL);
-
-    pthread_cancel(lift_shutdown);
-    pthread_join(lift_shutdown, NULL);
-
-    pthread_cancel(worker_thread_id);
-    pthread_join(worker_thread_id, NULL);
-
-    pthread_cancel(responder_thread_id);
-    pthread_join(responder_thread_id, NULL);
+    return NULL;
+}
 
-    // Czekanie na zakończenie wątków bramek
-    for (int i = 0; i < NUM_GATES; i++) {
-        pthread_cancel(gate_threads[i]);
-        pthread_join(gate_threads[i], NULL);
-    }    
+// Uruchomienie wątku sygnałów (sygnały muszą być już zablokowane we wszystkich wątkach)
+int start_signal_thread(const sigset_t* signals) {
 
-        // Zwolnienie pamieci dzielonej
-    if (shmdt(shared_usage) == -1) {
-        fprintf(stderr, "Blad: Nie udalo sie odlaczyc pamieci dzielonej.\n");
+    signal_fd = signalfd(-1, signals, SFD_CLOEXEC);
+    signal_stop_fd = eventfd(0, EFD_CLOEXEC);
+    if (signal_fd == -1 || signal_stop_fd == -1) {
+        return -1;
     }
-    if (shmctl(shm_id, IPC_RMID, NULL) == -1) {
-        fprintf(stderr, "Blad: Nie udalo sie usunac segmentu pamieci dzielonej.\n");
-    }
-
-    // Usuniecie kolejki komunikatow
-    if (msgctl(msgid, IPC_RMID, NULL) == -1) {
-        fprintf(stderr, "Blad: Nie udalo sie usunac kolejki komunikato w.\n");
+    if (pthread_create(&signal_thread_id, NULL, signal_thread, NULL) != 0) {
+        return -1;
     }
+    return 0;
+}
 
+// Zakończenie wątku sygnałów
+void stop_signal_thread(void) {
 
-    // Zwalnianie semaforów
-    sem_destroy(&platform_sem);
-    sem_destroy(&chairlift_sem);
-    sem_destroy(&vip_chairlift_sem);
-    for (int i = 0; i < NUM_GATES; i++) {
-        sem_destroy(&gates[i]);
-        sem_destroy(&gate_ready[i]);
+    uint64_t one = 1;
+    if (write(signal_stop_fd, &one, sizeof(one)) == sizeof(one)) {
+        pthread_join(signal_thread_id, NULL);
     }
-
-    printf("Zasoby zostaly zwolnione. Program zakonczyl dzialanie.\n");
-    exit(EXIT_SUCCESS);
+    close(signal_fd);
+    close(signal_stop_fd);
 }
 
-int main() {
-
-	signal(SIGINT, cleanup);
-	signal(SIGUSR2, statistic_signal_handler); 
-	srand(time(NULL));
-
-	// Inicjalizacja semaforów dla bramek z obsługą błędów
-	for (int i = 0; i < NUM_GATES; i++) {
-    		if (sem_init(&gates[i], 0, 0) == -1) {
-       	
-		fprintf(stderr, "Blad: Nie udalo sie zainicjalizowac semafora dla bramki #%d.\n", i);
-        	// Zwalnianie wczesniej zainicjalizowanych semaforów
-        	for (int j = 0; j < i; j++) {
-            		sem_destroy(&gates[j]);
-        	}
-        	exit(EXIT_FAILURE);
-   		}
-
-	if(sem_init(&gate_ready[i], 0, 0) == -1) {
-		fprintf(stderr, "Blad: Nie udalo się zainicjalizowac semafora 'gate_ready' dla bramki #%d.\n", i);
-		// Zwalnianie wcześniej zainicjalizowanych semaforów
-		sem_destroy(&gates[i]);
-		for (int j = 0; j < i; j++) {
-		sem_destroy(&gates[j]);
-		sem_destroy(&gate_ready[j]);
-		}
-       	exit(EXIT_FAILURE);
-    		}
-	}
+// Odłączenie księgi przejazdów i usunięcie kolejki komunikatów
+void release_ipc(void) {
 
+    struct timespec started, finished;
+    clock_gettime(CLOCK_MONOTONIC, &started);
+    ledger_close();
+    trace_close();
+    monitor_close();
 
-    // Inicjalizacja semaforów z obsługą błędów
-if (sem_init(&platform_sem, 0, MAX_PEOPLE_ON_PLATFORM) == -1) {
-    fprintf(stderr, "Blad: Nie udalo sie zainicjalizowac semafora platformy.\n");
-    exit(EXIT_FAILURE);
+	// Usunięcie kolejki komunikatów
+	if (msgctl(msgid, IPC_RMID, NULL) == -1) {
+  	  fprintf(stderr, "Błąd: Nie udało się usunąć kolejki komunikatów.\n");
+	}
+	clock_gettime(CLOCK_MONOTONIC, &finished);
+	ipc_release_ns = elapsed_ns(&started, &finished);
 }
 
-if (sem_init(&chairlift_sem, 0, MAX_CHAIRS * MAX_PEOPLE_ON_CHAIR) == -1) {
-    fprintf(stderr, "Blad: Nie udalo sie zainicjalizowac semafora kolejki linowej.\n");
-    sem_destroy(&platform_sem); // Usuniecie już zainicjalizowanego semafora
-    exit(EXIT_FAILURE);
-}
+int main(int argc, char* argv[]) {
+
+	// Konfiguracja stacji: --config plik, --set klucz=wartosc
+	if (config_parse_args(&config, argc, argv) == -1) {
+		exit(EXIT_FAILURE);
+	}
+	// Proces przybyć: --arrivals uniform|poisson|profile|burst|replay, --arrivals-file plik.csv, --arrival-profile wagi
+	if (arrivals_parse_args(argc, argv) == -1) {
+		exit(EXIT_FAILURE);
+	}
 
+	// Opcje: --des [liczba_dni], --procs, --pin, --log-level off|error|warn|info|debug, --plain, --seed N, --ledger plik,
+	// --trace plik, --usage-format text|csv|json, --monitor nazwa|off, --print-config
+	bool pin = false;
+	const char* ledger_path = DEFAULT_LEDGER_PATH;
+	const char* trace_path = NULL;
+	const char* monitor_name = MONITOR_DEFAULT_NAME;
+	UsageFormat usage_format = USAGE_TEXT;
+	uint64_t seed = (uint64_t)time(NULL);
+	int des_days = 1;
+	bool log_level_set = false;
+	LogLevel log_level = LOG_DEBUG;
+	LogFormat log_format = LOG_COLOR;
+	for (int i = 1; i < argc; i++) {
+		if (strcmp(argv[i], "--des") == 0) {
+			des_mode = true;
+			if (i + 1 < argc && argv[i + 1][0] != '-') {
+				des_days = atoi(argv[++i]);
+				if (des_days <= 0) {
+					fprintf(stderr, "Blad: Nieprawidlowa liczba dni symulacji: %s.\n", argv[i]);
+					exit(EXIT_FAILURE);
+				}
+			}
+		} else if (strcmp(argv[i], "--procs") == 0) {
+			procs_mode = true;
+		} else if (strcmp(argv[i], "--pin") == 0) {
+			pin = true;
+		} else if (strcmp(argv[i], "--log-level") == 0 && i + 1 < argc) {
+			if (log_parse_level(argv[++i], &log_level) == -1) {
+				fprintf(stderr, "Blad: Nieznany poziom dziennika: %s.\n", argv[i]);
+				exit(EXIT_FAILURE);
+			}
+			log_level_set = true;
+		} else if (strcmp(argv[i], "--plain") == 0) {
+			log_format = LOG_PLAIN;
+		} else if (strcmp(argv[i], "--seed") == 0 && i + 1 < argc) {
+			seed = strtoull(argv[++i], NULL, 10);
+		} else if (strcmp(argv[i], "--ledger") == 0 && i + 1 < argc) {
+			ledger_path = argv[++i];
+		} else if (strcmp(argv[i], "--trace") == 0 && i + 1 < argc) {
+			trace_path = argv[++i];
+		} else if (strcmp(argv[i], "--monitor") == 0 && i + 1 < argc) {
+			monitor_name = strcmp(argv[++i], "off") == 0 ? NULL : argv[i];
+		} else if (strcmp(argv[i], "--usage-format") == 0 && i + 1 < argc) {
+			if (usage_parse_format(argv[++i], &usage_format) == -1) {
+				fprintf(stderr, "Blad: Nieznany format raportu przejazdow: %s.\n", argv[i]);
+				exit(EXIT_FAILURE);
+			}
+		} else if ((config_is_option(argv[i]) || arrivals_is_option(argv[i])) && i + 1 < argc) {
+			i++; // Obsłużone przez config_parse_args i arrivals_parse_args
+		} else if (strcmp(argv[i], "--print-config") == 0) {
+			config_print(&config);
+			return 0;
+		} else {
+			fprintf(stderr, "Blad: Nieznana opcja: %s.\n", argv[i]);
+			exit(EXIT_FAILURE);
+		}
+	}
 
+	// Tryb zdarzeń dyskretnych domyślnie nie wypisuje kroków narciarzy
+	if (des_mode && !log_level_set) {
+		log_level = LOG_OFF;
+	}
+	// Sygnały blokujemy przed utworzeniem wątków i procesów; odbiera je tylko wątek sygnałów
+	sigset_t handled_signals;
+	sigemptyset(&handled_signals);
+	sigaddset(&handled_signals, SIGUSR2);
+	sigaddset(&handled_signals, SIGINT);
+	sigaddset(&handled_signals, SIGTERM);
+	pthread_sigmask(SIG_BLOCK, &handled_signals, NULL);
+	if (start_signal_thread(&handled_signals) == -1) {
+		fprintf(stderr, "Blad: Nie udalo sie uruchomic watku sygnalow.\n");
+		exit(EXIT_FAILURE);
+	}
 
-// Inicjalizacja semafora vip_chairlift_sem z obsługą błędów
-if (sem_init(&vip_chairlift_sem, 0, MAX_CHAIRS * MAX_PEOPLE_ON_CHAIR) == -1) {
-    fprintf(stderr, "Blad: Nie udalo sie zainicjalizowac semafora vip_chairlift_sem.\n");
-    sem_destroy(&chairlift_sem);
-    exit(EXIT_FAILURE);
-}
+	if (log_init(log_level, log_format) == -1) {
+		fprintf(stderr, "Blad: Nie udalo sie uruchomic watku dziennika.\n");
+		exit(EXIT_FAILURE);
+	}
+
+	// Jedno ziarno wyznacza strumienie wszystkich narciarzy i pracowników
+	rng_set_seed(seed);
+	printf("Ziarno losowania: %llu (powtorzenie symulacji: --seed %llu).\n",
+	       (unsigned long long)seed, (unsigned long long)seed);
+	arrivals_print_settings();
 
-    // Inicjalizacja pamięci dzielonej
-    int shm_id = shmget(IPC_PRIVATE, sizeof(int) * 1000, IPC_CREAT | 0600); // Zakładamy maksymalnie 1000 narciarzy
-    if (shm_id == -1) {
-        fprintf(stderr, "Blad: Nie udalo sie utworzyc pamieci dzielonej.\n");
+    // Księga przejazdów w pliku, rośnie wraz z liczbą narciarzy
+    if (ledger_open(ledger_path) == -1) {
+        fprintf(stderr, "Blad: Nie udalo sie utworzyc ksiegi przejazdow %s.\n", ledger_path);
         exit(EXIT_FAILURE); // Zakonczenie programu w przypadku bledu
-    }    
-    shared_usage = shmat(shm_id, NULL, 0);
-    if (shared_usage == (void*)-1) {
-        fprintf(stderr, "Blad: Nie udalo sie przydzielic pamieci dzielonej.\n");
-        shmctl(shm_id, IPC_RMID, NULL); // Usunięcie segmentu pamięci
-        exit(EXIT_FAILURE);
     }
-	
 
-    for (int i = 0; i < 1000; i++) {
-        shared_usage[i] = 0;
+    // Binarny ślad zdarzeń do analizy programem ski_replay
+    if (trace_path && trace_open(trace_path) == -1) {
+        fprintf(stderr, "Blad: Nie udalo sie utworzyc sladu zdarzen %s.\n", trace_path);
+        exit(EXIT_FAILURE);
     }
 
 // Inicjalizacja kolejki komunikatów z obsługą błędów
@@ -504,132 +409,147 @@ if (sem_init(&vip_chairlift_sem, 0, MAX_CHAIRS * MAX_PEOPLE_ON_CHAIR) == -1) {
     	exit(EXIT_FAILURE); // Zakończenie programu w przypadku błędu
 	}	
 
-    pthread_t time_thread, lift_shutdown;
-    pthread_create(&time_thread, NULL, time_simulation_thread, NULL);
-pthread_create(&lift_shutdown, NULL, lift_shutdown_thread, NULL);
-    
-// Tworzenie wątków dla bramek
-    pthread_t gate_threads[NUM_GATES];
-    for (int i = 0; i < NUM_GATES; i++) {
-        int* gate_id = malloc(sizeof(int));
-	if (!gate_id) {
-    		fprintf(stderr, "Błąd: Nie udało się przydzielić pamięci dla identyfikatora bramki.\n");
-    		exit(EXIT_FAILURE);
+	// Symulacja zdarzeń dyskretnych nie tworzy wątków, zegar przeskakuje do kolejnych zdarzeń
+	if (des_mode) {
+		des_run_season(des_days, true);
+		station_print_report();
+		log_shutdown();
+		stop_signal_thread();
+		usage_print_report(usage_format);
+		lockstat_print_report();
+		station_destroy();
+		hist_destroy();
+		lockstat_destroy();
+		usage_destroy();
+		release_ipc();
+		printf("Program zakończył działanie.\n");
+		return 0;
 	}
-        *gate_id = i;
-	if (pthread_create(&gate_threads[i], NULL, gate_thread, gate_id) != 0) {
-    		fprintf(stderr, "Błąd: Nie udało się utworzyć wątku dla bramki #%d.\n", i);
-    		free(gate_id); // Zwolnienie pamięci w przypadku błędu
-    		exit(EXIT_FAILURE);
-	}
-    }
 
-
-
-     // Tworzenie wątków pracowników
-    pthread_t worker_thread_id, responder_thread_id;
-    int* worker_id = malloc(sizeof(int));
-    if (!worker_id) {
-	    fprintf(stderr, "Błąd: Nie udało się przydzielić pamięci dla identyfikatora pracownika.\n");
-	    exit(EXIT_FAILURE);
+	// Pula wątków o rozmiarze liczby rdzeni wykonuje zadania wszystkich narciarzy
+	long num_threads = sysconf(_SC_NPROCESSORS_ONLN);
+	if (num_threads < 1) {
+		num_threads = 1;
 	}
-	*worker_id = 1;
-	if (pthread_create(&worker_thread_id, NULL, worker_thread, worker_id) != 0) {
-	    fprintf(stderr, "Błąd: Nie udało się utworzyć wątku dla pracownika.\n");
-	    free(worker_id); // Zwolnienie pamięci w przypadku błędu
-	    exit(EXIT_FAILURE);
+	if (station_init(&pool_scheduler) == -1 || pool_init((int)num_threads) == -1) {
+		fprintf(stderr, "Błąd: Nie udało się utworzyć puli wątków narciarzy.\n");
+		release_ipc();
+		exit(EXIT_FAILURE);
+	}
+	station_open_day();
+
+	// Podgląd na żywo dla ski_top; bez segmentu stacja działa dalej
+	if (monitor_name && monitor_start(monitor_name) == -1) {
+		if (errno == EEXIST) {
+			fprintf(stderr, "Uwaga: Segment podgladu %s juz istnieje (inna stacja?), podglad wylaczony.\n", monitor_name);
+		} else {
+			fprintf(stderr, "Uwaga: Nie udalo sie utworzyc segmentu podgladu %s.\n", monitor_name);
+		}
 	}
 
-    int* responder_id = malloc(sizeof(int));
-    if (!responder_id) {
-    fprintf(stderr, "Błąd: Nie udało się przydzielić pamięci dla identyfikatora pracownika.\n");
-    exit(EXIT_FAILURE);
+	// Sygnał przerwania odebrany przed otwarciem stacji zamyka ją od razu
+	atomic_store(&station_running, true);
+	if (atomic_load(&interrupted)) {
+		station_close();
 	}
-	*responder_id = 2;
-	if (pthread_create(&responder_thread_id, NULL, responder_thread, responder_id) != 0) {
-	    fprintf(stderr, "Błąd: Nie udało się utworzyć wątku dla respondenta.\n");
-	    free(responder_id); // Zwolnienie pamięci w przypadku błędu
-	    exit(EXIT_FAILURE);
+
+	// Pracownicy w osobnych procesach, uzgodnienia przez pierścienie w pamięci dzielonej
+	if (procs_mode) {
+		if (procs_start(pin) == -1) {
+			fprintf(stderr, "Blad: Nie udalo sie uruchomic procesow pracownikow.\n");
+			monitor_stop();
+			release_ipc(); // Kolejka komunikatów i segment podglądu przeżyłyby proces
+			exit(EXIT_FAILURE);
+		}
+		drain_station();
+		procs_stop();
+		drain_mark(DRAIN_WORKERS);
+		pool_shutdown();
+		log_shutdown();
+		stop_signal_thread();
+		drain_mark(DRAIN_POOL);
+		monitor_stop();
+
+		station_print_report();
+		procs_print_report(msgid);
+		usage_print_report(usage_format);
+		lockstat_print_report();
+		station_destroy();
+		hist_destroy();
+		lockstat_destroy();
+		usage_destroy();
+		release_ipc();
+		print_drain_report();
+		printf("Program zakończył działanie.\n");
+		return 0;
 	}
 
-    // Tworzenie wątków narciarzy w nieskończonej pętli
-    int skier_id = 0;
-    while (is_station_open) {
-        Skier* skier = malloc(sizeof(Skier));
-    	if (!skier) { // Sprawdzenie alokacji
-        	fprintf(stderr, "Błąd: Nie udało się przydzielić pamięci dla narciarza.\n");
-        	return NULL;
-    	}
-   	skier->skier_id = skier_id;
-        skier->age = rand() % 75 + 4;
-        skier->ticket = purchase_ticket(skier->skier_id, skier->age);
-        if (!skier->ticket) {
- 	 fprintf(stderr, "Błąd: Nie udało się utworzyć biletu dla narciarza #%d.\n", skier->skier_id);
-  	 free(skier); // Zwolnienie pamięci w przypadku błędu
-   	 continue; // Przejście do następnego narciarza
+     // Tworzenie wątków pracowników: para na każdą kolejkę
+    worker_thread_ids = malloc(sizeof(pthread_t) * config.num_lifts);
+    responder_thread_ids = malloc(sizeof(pthread_t) * config.num_lifts);
+    if (!worker_thread_ids || !responder_thread_ids) {
+	    fprintf(stderr, "Błąd: Nie udało się przydzielić pamięci dla wątków pracowników.\n");
+	    exit(EXIT_FAILURE);
 	}
-	skier->is_guardian = skier->age >= 18 && skier->age <= 65;
-       skier->is_child = skier->age >= 4 && skier->age <= 8;
-	skier->has_guardian = skier->is_child ? (rand() % 2) : -1;
-	skier->other_guarded_children_count = (skier->skier_id > 0) ? (rand() % skier->skier_id) : 0;
-       
-	pthread_t skier_thread_id;
-       pthread_create(&skier_thread_id, NULL, skier_thread, skier);
- int sleep_time_ms = (rand() % 3000) + 500; // Od 500 ms do 3 sekund
-    usleep(sleep_time_ms * 1000); // Zamiana milisekund na mikrosekundy
-        skier_id++;
+    for (int lift_id = 0; lift_id < config.num_lifts; lift_id++) {
+        int* worker_lift = malloc(sizeof(int));
+        int* responder_lift = malloc(sizeof(int));
+        if (!worker_lift || !responder_lift) {
+	        fprintf(stderr, "Błąd: Nie udało się przydzielić pamięci dla identyfikatora pracownika.\n");
+	        exit(EXIT_FAILURE);
+	    }
+	    *worker_lift = lift_id;
+	    *responder_lift = lift_id;
+	    if (pthread_create(&worker_thread_ids[lift_id], NULL, worker_thread, worker_lift) != 0) {
+	        fprintf(stderr, "Błąd: Nie udało się utworzyć wątku dla pracownika.\n");
+	        free(worker_lift); // Zwolnienie pamięci w przypadku błędu
+	        exit(EXIT_FAILURE);
+	    }
+	    if (pthread_create(&responder_thread_ids[lift_id], NULL, responder_thread, responder_lift) != 0) {
+	        fprintf(stderr, "Błąd: Nie udało się utworzyć wątku dla respondenta.\n");
+	        free(responder_lift); // Zwolnienie pamięci w przypadku błędu
+	        exit(EXIT_FAILURE);
+	    }
+	    worker_pairs = lift_id + 1;
     }
-    pthread_join(time_thread, NULL);
-    pthread_join(lift_shutdown, NULL);
-
-    // Wysłanie sygnału zakończenia do responder_thread
-    Message end_msg;
-    end_msg.message_type = 1;
-    snprintf(end_msg.message_text, sizeof(end_msg.message_text), "END");
-    msgsnd(msgid, &end_msg, sizeof(end_msg), 0);
-    pthread_join(worker_thread_id, NULL);
-    pthread_join(responder_thread_id, NULL);
-    pthread_join(skier_thread_id, NULL);
-	
-        // Zakonczenie pracy bramek
-	for (int i = 0; i < NUM_GATES; i++) {
-    	sem_post(&gates[i]); // Odblokowanie semaforow bramek
-	}
-	
 
-    // Wyświetlenie raportu po zakończeniu wszystkich wątków
-	sleep(5);
-    printf("\n[Raport dzienny z pamięci dzielonej]\n");
-    for (int i = 0; i < skier_id; i++) {
-        if (shared_usage[i] > 0) {
-            printf("Narciarz #%d wykonał %d zjazdów.\n", i, shared_usage[i]);
-        }
-    }
+    // Zamykanie stacji etapami, od bramek do powrotu narciarzy z tras
+    drain_station();
 
-    // Zakończenie wątków bramek
-    for (int i = 0; i < NUM_GATES; i++) {
-        pthread_join(gate_threads[i], NULL);
-        sem_destroy(&gates[i]);
-	    sem_destroy(&gate_ready[i]); 
+    // Pracownik kończy po opróżnieniu swojej kolejki; drugi pracownik po komunikacie END,
+    // wysłanym dopiero wtedy, gdy pierwszy nie może już poprosić o sprawdzenie gotowości
+    for (int i = 0; i < worker_pairs; i++) {
+        pthread_join(worker_thread_ids[i], NULL);
     }
-
-    // Zwolnienie pamięci dzielonej
-	
-    if (shmdt(shared_usage) == -1) {
-        fprintf(stderr, "Blad: Nie udało się odłączyć pamięci dzielonej.\n");
+    for (int i = 0; i < worker_pairs; i++) {
+        Message end_msg;
+        end_msg.message_type = LIFT_WORKER_ID(i);
+        snprintf(end_msg.message_text, sizeof(end_msg.message_text), "END");
+        msgsnd(msgid, &end_msg, sizeof(end_msg), 0);
     }
-    if (shmctl(shm_id, IPC_RMID, NULL) == -1) {
-        fprintf(stderr, "Blad: Nie udało się usunąć segmentu pamięci dzielonej.\n");
+    for (int i = 0; i < worker_pairs; i++) {
+        pthread_join(responder_thread_ids[i], NULL);
     }
+    free(worker_thread_ids);
+    free(responder_thread_ids);
+    drain_mark(DRAIN_WORKERS);
+    pool_shutdown();
+    log_shutdown();
+    stop_signal_thread();
+    drain_mark(DRAIN_POOL);
+    monitor_stop();
+
+    // Wyświetlenie raportu po zakończeniu wszystkich wątków
+    station_print_report();
+    usage_print_report(usage_format);
+    lockstat_print_report();
+    station_destroy();
+    hist_destroy();
+    lockstat_destroy();
+    usage_destroy();
+    release_ipc();
+    print_drain_report();
 
-	
-	// Usunięcie kolejki komunikatów
-	if (msgctl(msgid, IPC_RMID, NULL) == -1) {
-  	  fprintf(stderr, "Błąd: Nie udało się usunąć kolejki komunikatów.\n");
-	}
-   	 sem_destroy(&platform_sem);
-  	  sem_destroy(&chairlift_sem);
-	
     printf("Program zakończył działanie.\n");
     return 0;
 }
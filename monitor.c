@@ -0,0 +1,207 @@
+#include "monitor.h"
+#include "config.h"
+#include "station.h"
+#include "gate.h"
+#include "slope.h"
+#include <errno.h>
+#include <fcntl.h>
+#include <pthread.h>
+#include <stdbool.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <time.h>
+#include <unistd.h>
+
+_Static_assert(sizeof(MonitorHeader) <= MONITOR_HEADER_SIZE, "Naglowek podgladu jest za duzy");
+
+// Odczyt liczników użyty do przepustowości z ostatnich publikacji
+typedef struct {
+    sim_time_t time;
+    long passes;
+    long seats;
+} MonitorSample;
+
+static const char* segment_name;
+static MonitorHeader* header = NULL;
+static size_t segment_size;
+static unsigned char* snapshot;           // Dane budowane poza seqlockiem (układ jak w segmencie)
+static int64_t published;
+static MonitorSample window[MONITOR_WINDOW];
+static int window_count;
+static int window_next;
+
+static pthread_t publisher_id;
+static bool publisher_started;
+static bool stop_requested;
+static pthread_mutex_t stop_mutex = PTHREAD_MUTEX_INITIALIZER;
+static pthread_cond_t stop_cond = PTHREAD_COND_INITIALIZER;
+
+// Odczyt stanu stacji do lokalnej kopii; kolejki blokowane są tylko na czas skopiowania ich stanu
+static void collect(bool finished) {
+    int lifts = config.num_lifts;
+    int gates = config.num_gates;
+    int chairs = config.max_chairs;
+    MonitorStation* station = (MonitorStation*)(snapshot + MONITOR_HEADER_SIZE);
+    MonitorLift* lift_states = (MonitorLift*)(snapshot + monitor_lifts_offset());
+    int32_t* depths = (int32_t*)(snapshot + monitor_gates_offset(lifts));
+    unsigned char* occupancy = snapshot + monitor_chairs_offset(lifts, gates);
+
+    long seats = 0;
+    for (int l = 0; l < lifts; l++) {
+        LiftSample sample;
+        station_sample_lift(l, &sample, &occupancy[(size_t)l * chairs]);
+        MonitorLift* lift = &lift_states[l];
+        lift->on_platform = sample.on_platform;
+        lift->platform_waiting = sample.platform_waiting;
+        lift->on_chairs = sample.on_chairs;
+        lift->loading_chair = sample.loading_chair;
+        lift->state = sample.state;
+        lift->worker_id = LIFT_WORKER_ID(l);
+        lift->stops = sample.stops;
+        lift->carried = sample.carried;
+        seats += sample.carried;
+    }
+    for (int g = 0; g < lifts * gates; g++) {
+        depths[g] = (int32_t)gate_depth(g);
+    }
+
+    // Przepustowość z okna ostatnich publikacji; zegar cofnięty przez nowy dzień zaczyna okno od nowa
+    sim_time_t now = station_now();
+    long passes = gates_total_passes();
+    if (window_count > 0 && now < window[(window_next + MONITOR_WINDOW - 1) % MONITOR_WINDOW].time) {
+        window_count = 0;
+    }
+    window[window_next] = (MonitorSample){ now, passes, seats };
+    window_next = (window_next + 1) % MONITOR_WINDOW;
+    if (window_count < MONITOR_WINDOW) {
+        window_count++;
+    }
+    const MonitorSample* oldest = &window[(window_next + MONITOR_WINDOW - window_count) % MONITOR_WINDOW];
+    double hours = (now - oldest->time) / 3600.0;
+
+    StationStats stats = station_day_stats();
+    station->published = ++published;
+    station->sim_time = now;
+    station->station_open = is_station_open;
+    station->finished = finished;
+    station->skiers = stats.skiers;
+    station->rides = stats.rides;
+    station->lift_stops = stats.lift_stops;
+    station->on_slopes = slopes_skier_count();
+    station->gate_per_hour = hours > 0 ? (passes - oldest->passes) / hours : 0.0;
+    station->seats_per_hour = hours > 0 ? (seats - oldest->seats) / hours : 0.0;
+}
+
+// Zapis kopii do segmentu pod seqlockiem: jedyny piszący nie czeka na czytelników
+static void publish(void) {
+    unsigned seq = atomic_load_explicit(&header->seq, memory_order_relaxed);
+    atomic_store_explicit(&header->seq, seq + 1, memory_order_relaxed);
+    atomic_thread_fence(memory_order_release);
+    memcpy((unsigned char*)header + MONITOR_HEADER_SIZE, snapshot + MONITOR_HEADER_SIZE,
+           segment_size - MONITOR_HEADER_SIZE);
+    atomic_store_explicit(&header->seq, seq + 2, memory_order_release);
+}
+
+// Wątek publikujący stan co MONITOR_INTERVAL_MS, niezależnie od liczby podglądających
+static void* publisher_thread(void* arg) {
+    (void)arg;
+    pthread_mutex_lock(&stop_mutex);
+    while (!stop_requested) {
+        pthread_mutex_unlock(&stop_mutex);
+        collect(false);
+        publish();
+
+        struct timespec deadline;
+        clock_gettime(CLOCK_REALTIME, &deadline);
+        deadline.tv_nsec += MONITOR_INTERVAL_MS * 1000000L;
+        if (deadline.tv_nsec >= 1000000000L) {
+            deadline.tv_sec++;
+            deadline.tv_nsec -= 1000000000L;
+        }
+        pthread_mutex_lock(&stop_mutex);
+        while (!stop_requested && pthread_cond_timedwait(&stop_cond, &stop_mutex, &deadline) != ETIMEDOUT) {
+        }
+    }
+    pthread_mutex_unlock(&stop_mutex);
+    return NULL;
+}
+
+// Utworzenie segmentu o podanej nazwie i uruchomienie publikacji (stacja musi być już otwarta);
+// istniejącego segmentu (np. innej działającej stacji) nie przejmujemy ani nie usuwamy: errno == EEXIST
+int monitor_start(const char* name) {
+    segment_size = monitor_size(config.num_lifts, config.num_gates, config.max_chairs);
+    int fd = shm_open(name, O_RDWR | O_CREAT | O_EXCL, 0644);
+    if (fd == -1) {
+        return -1;
+    }
+    if (ftruncate(fd, (off_t)segment_size) == -1) {
+        close(fd);
+        shm_unlink(name);
+        return -1;
+    }
+    void* area = mmap(NULL, segment_size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    close(fd);
+    snapshot = calloc(1, segment_size);
+    if (area == MAP_FAILED || !snapshot) {
+        if (area != MAP_FAILED) {
+            munmap(area, segment_size);
+        }
+        free(snapshot);
+        snapshot = NULL;
+        shm_unlink(name);
+        return -1;
+    }
+
+    header = area;
+    memcpy(header->magic, MONITOR_MAGIC, sizeof(header->magic));
+    header->version = 1;
+    header->size = (uint32_t)segment_size;
+    header->pid = (int32_t)getpid();
+    header->num_lifts = config.num_lifts;
+    header->num_gates = config.num_gates;
+    header->num_chairs = config.max_chairs;
+    header->seats_per_chair = config.max_people_on_chair;
+    header->max_people_on_platform = config.max_people_on_platform;
+    header->opening_hour = config.opening_hour;
+    header->closing_hour = config.closing_hour;
+    atomic_init(&header->seq, 0);
+    segment_name = name;
+
+    collect(false);
+    publish();
+    stop_requested = false;
+    if (pthread_create(&publisher_id, NULL, publisher_thread, NULL) != 0) {
+        monitor_close();
+        return -1;
+    }
+    publisher_started = true;
+    return 0;
+}
+
+// Zatrzymanie publikacji i ostatni stan z oznaczeniem końca pracy (przed zwolnieniem struktur stacji)
+void monitor_stop(void) {
+    if (!publisher_started) {
+        return;
+    }
+    pthread_mutex_lock(&stop_mutex);
+    stop_requested = true;
+    pthread_cond_signal(&stop_cond);
+    pthread_mutex_unlock(&stop_mutex);
+    pthread_join(publisher_id, NULL);
+    publisher_started = false;
+    collect(true);
+    publish();
+}
+
+// Odłączenie i usunięcie segmentu; podglądający zachowują swoje odwzorowanie z ostatnim stanem
+void monitor_close(void) {
+    if (!header) {
+        return;
+    }
+    munmap(header, segment_size);
+    header = NULL;
+    shm_unlink(segment_name);
+    free(snapshot);
+    snapshot = NULL;
+}
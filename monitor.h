@@ -0,0 +1,82 @@
+#ifndef MONITOR_H
+#define MONITOR_H
+
+#include <stdatomic.h>
+#include <stddef.h>
+#include <stdint.h>
+
+// Układ segmentu pamięci dzielonej podglądu na żywo (czyta go program ski_top):
+//   [MonitorHeader, dopełniony do MONITOR_HEADER_SIZE][MonitorStation][MonitorLift x num_lifts]
+//   [głębokości kolejek bramek: int32 x num_lifts * num_gates][zapełnienie krzesełek: uint8 x num_lifts * num_chairs]
+// Wszystko za nagłówkiem chroni licznik seq (seqlock): nieparzysty w trakcie zapisu, więc jedyny piszący
+// nigdy nie czeka, a czytelnik kopiuje dane i powtarza odczyt, gdy licznik się zmienił.
+#define MONITOR_MAGIC "SKIMON01"
+#define MONITOR_DEFAULT_NAME "/ski_station"
+#define MONITOR_HEADER_SIZE 128
+#define MONITOR_INTERVAL_MS 100   // Odstęp kolejnych publikacji
+#define MONITOR_WINDOW 50         // Publikacje, z których liczona jest bieżąca przepustowość (ok. 5 s)
+
+// Parametry stałe przez cały czas pracy stacji
+typedef struct {
+    char magic[8];
+    uint32_t version;
+    uint32_t size;                // Rozmiar całego segmentu
+    int32_t pid;                  // Proces stacji
+    int32_t num_lifts;
+    int32_t num_gates;            // Bramek jednej kolejki
+    int32_t num_chairs;           // Krzesełek jednej kolejki
+    int32_t seats_per_chair;
+    int32_t max_people_on_platform;
+    int32_t opening_hour;
+    int32_t closing_hour;
+    _Alignas(64) atomic_uint seq; // Licznik seqlocka
+} MonitorHeader;
+
+// Stan całej stacji
+typedef struct {
+    int64_t published;            // Numer publikacji
+    int64_t sim_time;             // Czas symulowany od otwarcia (s)
+    int32_t station_open;
+    int32_t finished;             // Stacja zakończyła pracę (ostatnia publikacja)
+    int32_t skiers;               // Przybyli narciarze bieżącego dnia
+    int32_t rides;                // Zjazdy bieżącego dnia
+    int32_t lift_stops;           // Zatrzymania kolejek bieżącego dnia
+    int32_t on_slopes;            // Narciarze na trasach
+    double gate_per_hour;         // Przejścia przez bramki na godzinę (ostatnie MONITOR_WINDOW publikacji)
+    double seats_per_hour;        // Zajęte miejsca na krzesełkach na godzinę (jw.)
+} MonitorStation;
+
+// Stan jednej kolejki
+typedef struct {
+    int32_t on_platform;
+    int32_t platform_waiting;     // Czekający na miejsce na peronie
+    int32_t on_chairs;
+    int32_t loading_chair;        // Krzesełko w punkcie załadunku
+    uint32_t state;               // Flagi LIFT_* (station.h)
+    int32_t worker_id;            // Pracownik zatrzymujący kolejkę
+    int64_t stops;                // Zatrzymania przez pracownika
+    int64_t carried;              // Przewiezieni narciarze
+} MonitorLift;
+
+static inline size_t monitor_lifts_offset(void) {
+    return MONITOR_HEADER_SIZE + sizeof(MonitorStation);
+}
+
+static inline size_t monitor_gates_offset(int num_lifts) {
+    return monitor_lifts_offset() + sizeof(MonitorLift) * (size_t)num_lifts;
+}
+
+static inline size_t monitor_chairs_offset(int num_lifts, int num_gates) {
+    return monitor_gates_offset(num_lifts) + sizeof(int32_t) * (size_t)num_lifts * num_gates;
+}
+
+static inline size_t monitor_size(int num_lifts, int num_gates, int num_chairs) {
+    return monitor_chairs_offset(num_lifts, num_gates) + (size_t)num_lifts * num_chairs;
+}
+
+// Funkcje publikującego (stacja); bez otwartego segmentu podgląd jest pomijany
+int monitor_start(const char* name);
+void monitor_stop(void);
+void monitor_close(void);
+
+#endif
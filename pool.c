@@ -0,0 +1,207 @@
+#include "pool.h"
+#include "lockstat.h"
+#include "config.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+
+#define POOL_INITIAL_CAPACITY 256
+
+// Zadanie gotowe do wykonania
+typedef struct {
+    DesHandler handler;
+    void* arg;
+} PoolTask;
+
+// Stan puli wątków
+static struct {
+    pthread_t* threads;
+    int num_threads;
+    pthread_t timer_thread;
+
+    pthread_mutex_t mutex;       // Chroni kolejkę gotowych zadań
+    pthread_cond_t not_empty;
+    PoolTask* tasks;             // Bufor cykliczny gotowych zadań
+    int head;
+    int count;
+    int capacity;
+
+    pthread_mutex_t timer_mutex; // Chroni kopiec zadań odroczonych
+    pthread_cond_t timer_cond;
+    Des timers;                  // Zadania odroczone według czasu symulowanego
+
+    struct timespec start;       // Chwila startu symulacji
+    volatile bool stopping;
+} pool;
+
+// Bieżący czas symulowany wyliczony z zegara rzeczywistego
+sim_time_t pool_now(void) {
+    struct timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    long long elapsed_ns = (now.tv_sec - pool.start.tv_sec) * 1000000000LL + (now.tv_nsec - pool.start.tv_nsec);
+    return (sim_time_t)(elapsed_ns * config.sim_seconds_per_step / 1000000000LL);
+}
+
+// Chwila rzeczywista, w której upływa podany czas symulowany
+static struct timespec wall_time_of(sim_time_t time) {
+    long long ns = (long long)time * 1000000000LL / config.sim_seconds_per_step;
+    struct timespec deadline = pool.start;
+    deadline.tv_sec += ns / 1000000000LL;
+    deadline.tv_nsec += ns % 1000000000LL;
+    if (deadline.tv_nsec >= 1000000000L) {
+        deadline.tv_sec++;
+        deadline.tv_nsec -= 1000000000L;
+    }
+    return deadline;
+}
+
+// Dodanie zadania do kolejki gotowych
+void pool_submit(DesHandler handler, void* arg) {
+    LOCK_MUTEX(&pool.mutex, LOCK_POOL, 0);
+    if (pool.count == pool.capacity) {
+        PoolTask* tasks = malloc(sizeof(PoolTask) * pool.capacity * 2);
+        if (!tasks) {
+            fprintf(stderr, "Blad: Nie udalo sie powiekszyc kolejki zadan puli watkow.\n");
+            exit(EXIT_FAILURE);
+        }
+        for (int i = 0; i < pool.count; i++) {
+            tasks[i] = pool.tasks[(pool.head + i) % pool.capacity];
+        }
+        free(pool.tasks);
+        pool.tasks = tasks;
+        pool.head = 0;
+        pool.capacity *= 2;
+    }
+    pool.tasks[(pool.head + pool.count) % pool.capacity] = (PoolTask){ handler, arg };
+    pool.count++;
+    pthread_cond_signal(&pool.not_empty);
+    pthread_mutex_unlock(&pool.mutex);
+}
+
+// Zadanie do wykonania za 'delay' sekund symulowanych
+void pool_schedule(sim_time_t delay, DesHandler handler, void* arg) {
+    if (delay <= 0) {
+        pool_submit(handler, arg);
+        return;
+    }
+
+    LOCK_MUTEX(&pool.timer_mutex, LOCK_TIMER, 0);
+    pool.timers.now = pool_now();
+    if (des_schedule(&pool.timers, delay, handler, arg) == -1) {
+        fprintf(stderr, "Blad: Nie udalo sie zaplanowac zadania puli watkow.\n");
+        exit(EXIT_FAILURE);
+    }
+    pthread_cond_signal(&pool.timer_cond);
+    pthread_mutex_unlock(&pool.timer_mutex);
+}
+
+// Wątek puli: wykonuje kolejne gotowe zadania
+static void* pool_thread(void* arg) {
+    (void)arg;
+
+    while (true) {
+        LOCK_MUTEX(&pool.mutex, LOCK_POOL, 0);
+        while (pool.count == 0 && !pool.stopping) {
+            WAIT_COND(&pool.not_empty, &pool.mutex, LOCK_POOL_IDLE, 0);
+        }
+        if (pool.count == 0) {
+            pthread_mutex_unlock(&pool.mutex);
+            break;
+        }
+        PoolTask task = pool.tasks[pool.head];
+        pool.head = (pool.head + 1) % pool.capacity;
+        pool.count--;
+        pthread_mutex_unlock(&pool.mutex);
+
+        task.handler(task.arg);
+    }
+    return NULL;
+}
+
+// Wątek zegara: przekazuje zadania odroczone do puli, gdy nadejdzie ich czas
+static void* timer_thread(void* arg) {
+    (void)arg;
+
+    LOCK_MUTEX(&pool.timer_mutex, LOCK_TIMER, 0);
+    while (!pool.stopping) {
+        if (pool.timers.size == 0) {
+            WAIT_COND(&pool.timer_cond, &pool.timer_mutex, LOCK_TIMER_IDLE, 0);
+            continue;
+        }
+        if (pool.timers.heap[0].time <= pool_now()) {
+            DesEvent event;
+            des_pop(&pool.timers, &event);
+            pthread_mutex_unlock(&pool.timer_mutex);
+            pool_submit(event.handler, event.arg);
+            LOCK_MUTEX(&pool.timer_mutex, LOCK_TIMER, 0);
+            continue;
+        }
+        struct timespec deadline = wall_time_of(pool.timers.heap[0].time);
+        WAIT_COND_UNTIL(&pool.timer_cond, &pool.timer_mutex, &deadline, LOCK_TIMER_IDLE, 0);
+    }
+    pthread_mutex_unlock(&pool.timer_mutex);
+    return NULL;
+}
+
+// Uruchomienie puli wątków i zegara
+int pool_init(int num_threads) {
+    pool.num_threads = num_threads;
+    pool.stopping = false;
+    pool.head = 0;
+    pool.count = 0;
+    pool.capacity = POOL_INITIAL_CAPACITY;
+    pool.tasks = malloc(sizeof(PoolTask) * pool.capacity);
+    pool.threads = malloc(sizeof(pthread_t) * num_threads);
+    if (!pool.tasks || !pool.threads || des_init(&pool.timers) == -1) {
+        free(pool.tasks);
+        free(pool.threads);
+        return -1;
+    }
+
+    pthread_mutex_init(&pool.mutex, NULL);
+    pthread_cond_init(&pool.not_empty, NULL);
+    pthread_mutex_init(&pool.timer_mutex, NULL);
+    pthread_condattr_t attr;
+    pthread_condattr_init(&attr);
+    pthread_condattr_setclock(&attr, CLOCK_MONOTONIC);
+    pthread_cond_init(&pool.timer_cond, &attr);
+    pthread_condattr_destroy(&attr);
+    clock_gettime(CLOCK_MONOTONIC, &pool.start);
+
+    if (pthread_create(&pool.timer_thread, NULL, timer_thread, NULL) != 0) {
+        return -1;
+    }
+    for (int i = 0; i < num_threads; i++) {
+        if (pthread_create(&pool.threads[i], NULL, pool_thread, NULL) != 0) {
+            pool.num_threads = i;
+            pool_shutdown();
+            return -1;
+        }
+    }
+    return 0;
+}
+
+// Zatrzymanie puli, zadania odroczone są porzucane
+void pool_shutdown(void) {
+    LOCK_MUTEX(&pool.timer_mutex, LOCK_TIMER, 0);
+    pool.stopping = true;
+    pthread_cond_broadcast(&pool.timer_cond);
+    pthread_mutex_unlock(&pool.timer_mutex);
+    pthread_join(pool.timer_thread, NULL);
+
+    LOCK_MUTEX(&pool.mutex, LOCK_POOL, 0);
+    pthread_cond_broadcast(&pool.not_empty);
+    pthread_mutex_unlock(&pool.mutex);
+    for (int i = 0; i < pool.num_threads; i++) {
+        pthread_join(pool.threads[i], NULL);
+    }
+
+    des_destroy(&pool.timers);
+    free(pool.tasks);
+    free(pool.threads);
+    pool.tasks = NULL;
+    pool.threads = NULL;
+    pool.num_threads = 0;
+}
+
+const Scheduler pool_scheduler = { pool_now, pool_schedule };
@@ -0,0 +1,17 @@
+#ifndef POOL_H
+#define POOL_H
+
+#include "des.h"
+#include "station.h"
+
+// Pula wątków wykonująca zadania narciarzy w czasie rzeczywistym
+int pool_init(int num_threads);
+void pool_submit(DesHandler handler, void* arg);
+void pool_schedule(sim_time_t delay, DesHandler handler, void* arg);
+sim_time_t pool_now(void);
+void pool_shutdown(void);
+
+// Planista stacji oparty na puli wątków
+extern const Scheduler pool_scheduler;
+
+#endif
@@ -0,0 +1,325 @@
+#define _GNU_SOURCE
+#include "procs.h"
+#include "ring.h"
+#include "futex.h"
+#include "station.h"
+#include "log.h"
+#include <limits.h>
+#include <pthread.h>
+#include <sched.h>
+#include <signal.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <sys/mman.h>
+#include <sys/msg.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+#define PING_REQUEST 1000001  // Typy komunikatów porównania w kolejce System V (poza numerami pracowników)
+#define PING_REPLY 1000002
+
+// Typy komunikatów w pierścieniach
+typedef enum {
+    PROC_STOP,    // Pracownik zatrzymuje kolejkę
+    PROC_RESUME,  // Pracownik wznawia kolejkę
+    PROC_CHECK,   // Prośba o sprawdzenie gotowości
+    PROC_READY,   // Gotowość (value: czas sprawdzania w ns)
+    PROC_PING,
+    PROC_END
+} ProcMessageType;
+
+// Pierścienie jednej kolejki; każdy ma jednego nadawcę i jednego odbiorcę
+typedef struct {
+    ShmRing worker_to_station;    // Pracownik -> sterowanie kolejką
+    ShmRing worker_to_responder;  // Pracownik -> drugi pracownik
+    ShmRing responder_to_worker;  // Drugi pracownik -> pracownik
+} ProcLift;
+
+// Region pamięci dzielonej: liczniki wspólne i pierścienie każdej kolejki
+typedef struct {
+    atomic_uint open;             // Czy stacja jest otwarta (futeks budzi pracowników przy zamknięciu)
+    atomic_long handshakes;       // Liczba uzgodnień zatrzymania i wznowienia
+    atomic_llong handshake_ns;    // Łączny narzut uzgodnień (bez czasu sprawdzania)
+    atomic_llong handshake_max_ns;
+    ProcLift lifts[];
+} ProcRegion;
+
+// Komunikat kolejki System V o rozmiarze takim jak w trybie wątków
+typedef struct {
+    long message_type;
+    char message_text[100];
+} PingMessage;
+
+static ProcRegion* region = NULL;
+static size_t region_size;
+static int num_lifts;
+static pid_t* worker_pids;       // Procesy pracowników (indeks = numer kolejki)
+static pid_t* responder_pids;
+static pthread_t* control_thread_ids;
+static int control_threads;      // Liczba uruchomionych wątków sterowania
+
+// Przypięcie procesu do rdzenia (pomijane na maszynie z jednym rdzeniem)
+static void pin_to_cpu(int index) {
+    long cpus = sysconf(_SC_NPROCESSORS_ONLN);
+    if (cpus < 2) {
+        return;
+    }
+    cpu_set_t set;
+    CPU_ZERO(&set);
+    CPU_SET(index % cpus, &set);
+    sched_setaffinity(0, sizeof(set), &set);
+}
+
+static void send_message(ShmRing* ring, int type, int sender, uint64_t value) {
+    RingMessage message = { type, sender, value };
+    ring_push(ring, &message);
+}
+
+// Proces pracownika: losowo zatrzymuje kolejkę i czeka na gotowość drugiego pracownika.
+// Po fork() używa tylko wywołań systemowych i pamięci dzielonej.
+static void worker_process(int lift_id) {
+    ProcLift* lift = &region->lifts[lift_id];
+    int worker_id = LIFT_WORKER_ID(lift_id);
+    Rng rng;
+    rng_init(&rng, RNG_STREAM_WORKER + worker_id);
+
+    while (atomic_load(&region->open)) {
+        if (rng_below(&rng, 10) == 0) { // 10% szans na zatrzymanie kolejki
+            send_message(&lift->worker_to_station, PROC_STOP, worker_id, 0);
+
+            uint64_t sent = ring_clock_ns();
+            send_message(&lift->worker_to_responder, PROC_CHECK, worker_id, 0);
+            RingMessage reply;
+            ring_pop(&lift->responder_to_worker, &reply);
+            long long overhead = (long long)(ring_clock_ns() - sent - reply.value);
+
+            atomic_fetch_add(&region->handshakes, 1);
+            atomic_fetch_add(&region->handshake_ns, overhead);
+            long long max = atomic_load(&region->handshake_max_ns);
+            while (overhead > max && !atomic_compare_exchange_weak(&region->handshake_max_ns, &max, overhead)) {
+            }
+
+            send_message(&lift->worker_to_station, PROC_RESUME, worker_id, 0);
+        }
+        futex_wait_timeout(&region->open, 1, 1000); // Czas pracy pracownika, przerywany zamknięciem
+    }
+
+    send_message(&lift->worker_to_responder, PROC_END, worker_id, 0);
+    send_message(&lift->worker_to_station, PROC_END, worker_id, 0);
+    _exit(EXIT_SUCCESS);
+}
+
+// Proces drugiego pracownika: sprawdza gotowość i odsyła czas sprawdzania
+static void responder_process(int lift_id) {
+    ProcLift* lift = &region->lifts[lift_id];
+    while (true) {
+        RingMessage message;
+        ring_pop(&lift->worker_to_responder, &message);
+        if (message.type == PROC_END) {
+            break;
+        }
+        uint64_t started = ring_clock_ns();
+        sleep(config.responder_time); // Symulacja sprawdzania gotowosci
+        send_message(&lift->responder_to_worker, PROC_READY, LIFT_RESPONDER_ID(lift_id), ring_clock_ns() - started);
+    }
+    _exit(EXIT_SUCCESS);
+}
+
+// Wątek sterowania kolejką w procesie stacji: wykonuje polecenia jej pracownika
+static void* control_thread(void* arg) {
+    ProcLift* lift = arg;
+    int lift_id = (int)(lift - region->lifts);
+    while (true) {
+        RingMessage message;
+        ring_pop(&lift->worker_to_station, &message);
+        if (message.type == PROC_END) {
+            log_event(EV_WORKER_DONE, message.sender, 0);
+            break;
+        }
+        if (message.type == PROC_STOP) {
+            stop_lift(lift_id, message.sender);
+            log_event(EV_WORKER_REQUEST, message.sender, LIFT_RESPONDER_ID(lift_id));
+        } else if (message.type == PROC_RESUME) {
+            log_event(EV_WORKER_REPLY, message.sender, LIFT_RESPONDER_ID(lift_id));
+            resume_lift(lift_id, message.sender);
+        }
+    }
+    return NULL;
+}
+
+static pid_t spawn(void (*body)(int), int lift_id, int cpu, bool pin) {
+    pid_t pid = fork();
+    if (pid == 0) {
+        if (pin) {
+            pin_to_cpu(cpu);
+        }
+        body(lift_id);
+    }
+    return pid;
+}
+
+// Utworzenie regionu pamięci dzielonej i pary procesów pracowników dla każdej kolejki
+int procs_start(bool pin) {
+    num_lifts = config.num_lifts;
+    region_size = sizeof(ProcRegion) + sizeof(ProcLift) * num_lifts;
+    region = mmap(NULL, region_size, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_ANONYMOUS, -1, 0);
+    if (region == MAP_FAILED) {
+        region = NULL;
+        return -1;
+    }
+    worker_pids = malloc(sizeof(pid_t) * num_lifts);
+    responder_pids = malloc(sizeof(pid_t) * num_lifts);
+    control_thread_ids = malloc(sizeof(pthread_t) * num_lifts);
+    if (!worker_pids || !responder_pids || !control_thread_ids) {
+        procs_kill();
+        return -1;
+    }
+    for (int l = 0; l < num_lifts; l++) {
+        ring_init(&region->lifts[l].worker_to_station);
+        ring_init(&region->lifts[l].worker_to_responder);
+        ring_init(&region->lifts[l].responder_to_worker);
+        worker_pids[l] = responder_pids[l] = -1;
+    }
+    atomic_init(&region->open, 1);
+    atomic_init(&region->handshakes, 0);
+    atomic_init(&region->handshake_ns, 0);
+    atomic_init(&region->handshake_max_ns, 0);
+
+    // Rdzeń 0 zostaje dla procesu stacji (bramki, kolejka, pula narciarzy)
+    for (int l = 0; l < num_lifts; l++) {
+        responder_pids[l] = spawn(responder_process, l, LIFT_RESPONDER_ID(l), pin);
+        worker_pids[l] = spawn(worker_process, l, LIFT_WORKER_ID(l), pin);
+        if (responder_pids[l] == -1 || worker_pids[l] == -1) {
+            procs_kill();
+            return -1;
+        }
+    }
+    for (control_threads = 0; control_threads < num_lifts; control_threads++) {
+        if (pthread_create(&control_thread_ids[control_threads], NULL, control_thread,
+                           &region->lifts[control_threads]) != 0) {
+            procs_kill();
+            return -1;
+        }
+    }
+    return 0;
+}
+
+// Zamknięcie stacji: pracownicy budzą się od razu, kończą bieżący krok i zawiadamiają pozostałych
+void procs_stop(void) {
+    atomic_store(&region->open, 0);
+    futex_wake(&region->open, INT_MAX);
+    for (int l = 0; l < num_lifts; l++) {
+        waitpid(worker_pids[l], NULL, 0);
+        waitpid(responder_pids[l], NULL, 0);
+        worker_pids[l] = responder_pids[l] = -1;
+    }
+    for (int i = 0; i < control_threads; i++) {
+        pthread_join(control_thread_ids[i], NULL);
+    }
+    control_threads = 0;
+}
+
+// Natychmiastowe zakończenie procesów pracowników (błąd startu)
+void procs_kill(void) {
+    for (int l = 0; worker_pids && responder_pids && l < num_lifts; l++) {
+        if (worker_pids[l] > 0) {
+            kill(worker_pids[l], SIGTERM);
+            waitpid(worker_pids[l], NULL, 0);
+        }
+        if (responder_pids[l] > 0) {
+            kill(responder_pids[l], SIGTERM);
+            waitpid(responder_pids[l], NULL, 0);
+        }
+        worker_pids[l] = responder_pids[l] = -1;
+    }
+}
+
+static int compare_ns(const void* a, const void* b) {
+    uint64_t x = *(const uint64_t*)a;
+    uint64_t y = *(const uint64_t*)b;
+    return (x > y) - (x < y);
+}
+
+static void print_latency(const char* name, uint64_t* samples, int count) {
+    qsort(samples, count, sizeof(uint64_t), compare_ns);
+    printf("- %s: mediana %.2f us, p99 %.2f us, max %.2f us.\n", name,
+           samples[count / 2] / 1000.0, samples[count * 99 / 100] / 1000.0, samples[count - 1] / 1000.0);
+}
+
+// Porównanie wymiany komunikatów: pierścienie z futeksem i kolejka komunikatów System V
+static void compare_latency(int msgid) {
+    uint64_t* ring_ns = malloc(sizeof(uint64_t) * PROCS_PING_ROUNDS);
+    uint64_t* queue_ns = malloc(sizeof(uint64_t) * PROCS_PING_ROUNDS);
+    if (!ring_ns || !queue_ns) {
+        free(ring_ns);
+        free(queue_ns);
+        return;
+    }
+    ring_init(&region->lifts[0].worker_to_responder);
+    ring_init(&region->lifts[0].responder_to_worker);
+
+    pid_t echo = fork();
+    if (echo == 0) {
+        for (int i = 0; i < PROCS_PING_ROUNDS; i++) {
+            RingMessage message;
+            ring_pop(&region->lifts[0].worker_to_responder, &message);
+            ring_push(&region->lifts[0].responder_to_worker, &message);
+        }
+        PingMessage ping;
+        for (int i = 0; i < PROCS_PING_ROUNDS; i++) {
+            msgrcv(msgid, &ping, sizeof(ping.message_text), PING_REQUEST, 0);
+            ping.message_type = PING_REPLY;
+            msgsnd(msgid, &ping, sizeof(ping.message_text), 0);
+        }
+        _exit(EXIT_SUCCESS);
+    }
+    if (echo == -1) {
+        free(ring_ns);
+        free(queue_ns);
+        return;
+    }
+
+    for (int i = 0; i < PROCS_PING_ROUNDS; i++) {
+        uint64_t sent = ring_clock_ns();
+        send_message(&region->lifts[0].worker_to_responder, PROC_PING, 0, 0);
+        RingMessage reply;
+        ring_pop(&region->lifts[0].responder_to_worker, &reply);
+        ring_ns[i] = ring_clock_ns() - sent;
+    }
+    PingMessage ping = { PING_REQUEST, "" };
+    for (int i = 0; i < PROCS_PING_ROUNDS; i++) {
+        uint64_t sent = ring_clock_ns();
+        ping.message_type = PING_REQUEST;
+        msgsnd(msgid, &ping, sizeof(ping.message_text), 0);
+        msgrcv(msgid, &ping, sizeof(ping.message_text), PING_REPLY, 0);
+        queue_ns[i] = ring_clock_ns() - sent;
+    }
+    waitpid(echo, NULL, 0);
+
+    printf("Porownanie wymiany komunikatu tam i z powrotem (%d prob):\n", PROCS_PING_ROUNDS);
+    print_latency("Pierscienie w pamieci dzielonej", ring_ns, PROCS_PING_ROUNDS);
+    print_latency("Kolejka komunikatow System V", queue_ns, PROCS_PING_ROUNDS);
+    free(ring_ns);
+    free(queue_ns);
+}
+
+// Raport uzgodnień pracowników i porównanie z kolejką komunikatów; zwalnia region
+void procs_print_report(int msgid) {
+    printf("\n[Raport trybu wieloprocesowego]\n");
+    long handshakes = atomic_load(&region->handshakes);
+    if (handshakes > 0) {
+        printf("- Uzgodnienia zatrzymania i wznowienia: %ld, narzut sredni %.2f us, max %.2f us.\n", handshakes,
+               atomic_load(&region->handshake_ns) / 1000.0 / handshakes,
+               atomic_load(&region->handshake_max_ns) / 1000.0);
+    } else {
+        printf("- Brak uzgodnien zatrzymania i wznowienia.\n");
+    }
+    compare_latency(msgid);
+    munmap(region, region_size);
+    region = NULL;
+    free(worker_pids);
+    free(responder_pids);
+    free(control_thread_ids);
+    worker_pids = responder_pids = NULL;
+    control_thread_ids = NULL;
+}
@@ -0,0 +1,14 @@
+#ifndef PROCS_H
+#define PROCS_H
+
+#include <stdbool.h>
+
+#define PROCS_PING_ROUNDS 10000 // Wymian w porównaniu opóźnień pierścieni i kolejki komunikatów
+
+// Tryb wieloprocesowy: pracownicy jako osobne procesy połączone pierścieniami w pamięci dzielonej
+int procs_start(bool pin);
+void procs_stop(void);
+void procs_kill(void);
+void procs_print_report(int msgid);
+
+#endif
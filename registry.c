@@ -0,0 +1,168 @@
+#include "registry.h"
+#include "lockstat.h"
+#include <pthread.h>
+#include <stdatomic.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+#define FLAG_REGISTERED 0x01
+#define FLAG_VIP        0x02
+#define FLAG_DISCOUNT_SHIFT 2
+
+// Blok rejestru w układzie kolumnowym: bramka czyta tylko kolumny ważności i flag
+typedef struct {
+    int32_t expiry[REGISTRY_CHUNK];    // Koniec ważności (w sekundach od otwarcia)
+    uint8_t flags[REGISTRY_CHUNK];     // Zarejestrowany, VIP, klasa zniżki
+    atomic_int usage[REGISTRY_CHUNK];  // Liczba przejść przez bramki
+} RegistryChunk;
+
+// Blok dziennika przejść
+typedef struct PassBlock {
+    struct PassBlock* next;
+    int used;
+    GatePass passes[REGISTRY_LOG_CHUNK];
+} PassBlock;
+
+// Dziennik jednej bramki bez blokad: zapisuje go tylko zadanie tej bramki, a gate_task (station.c) planuje
+// następne zadanie bramki dopiero po zapisaniu przejścia, więc naraz działa co najwyżej jedno
+typedef struct {
+    _Alignas(64) PassBlock* head;
+    PassBlock* tail;
+    atomic_long passes;
+    atomic_long rejected;
+} PassLog;
+
+static _Atomic(RegistryChunk*) chunks[REGISTRY_MAX_CHUNKS];
+static pthread_mutex_t grow_mutex = PTHREAD_MUTEX_INITIALIZER;
+static PassLog* logs;     // Dzienniki bramek (num_gates)
+static int num_logs;
+
+// Blok rejestru dla biletu; nowy blok powstaje tylko przy rejestracji
+static RegistryChunk* registry_chunk(int ticket_id, bool create) {
+    if (ticket_id < 0 || ticket_id / REGISTRY_CHUNK >= REGISTRY_MAX_CHUNKS) {
+        return NULL;
+    }
+    int index = ticket_id / REGISTRY_CHUNK;
+    RegistryChunk* chunk = atomic_load_explicit(&chunks[index], memory_order_acquire);
+    if (chunk || !create) {
+        return chunk;
+    }
+
+    LOCK_MUTEX(&grow_mutex, LOCK_REGISTRY_GROW, 0);
+    chunk = atomic_load_explicit(&chunks[index], memory_order_relaxed);
+    if (!chunk) {
+        chunk = calloc(1, sizeof(RegistryChunk));
+        atomic_store_explicit(&chunks[index], chunk, memory_order_release);
+    }
+    pthread_mutex_unlock(&grow_mutex);
+    return chunk;
+}
+
+// Utworzenie pustych dzienników bramek
+int registry_init(int num_gates) {
+    registry_destroy();
+    logs = aligned_alloc(64, sizeof(PassLog) * num_gates);
+    if (!logs) {
+        return -1;
+    }
+    for (int i = 0; i < num_gates; i++) {
+        logs[i].head = NULL;
+        logs[i].tail = NULL;
+        atomic_init(&logs[i].passes, 0);
+        atomic_init(&logs[i].rejected, 0);
+    }
+    num_logs = num_gates;
+    return 0;
+}
+
+// Zwolnienie rejestru i dzienników
+void registry_destroy(void) {
+    for (int i = 0; i < REGISTRY_MAX_CHUNKS; i++) {
+        free(atomic_exchange(&chunks[i], NULL));
+    }
+    for (int i = 0; i < num_logs; i++) {
+        while (logs[i].head) {
+            PassBlock* next = logs[i].head->next;
+            free(logs[i].head);
+            logs[i].head = next;
+        }
+    }
+    free(logs);
+    logs = NULL;
+    num_logs = 0;
+}
+
+// Rejestracja sprzedanego biletu
+int registry_add(int ticket_id, sim_time_t expiry, bool is_vip, DiscountClass discount) {
+    RegistryChunk* chunk = registry_chunk(ticket_id, true);
+    if (!chunk) {
+        fprintf(stderr, "Blad: Brak miejsca w rejestrze dla biletu #%d.\n", ticket_id);
+        return -1;
+    }
+    int slot = ticket_id % REGISTRY_CHUNK;
+    chunk->expiry[slot] = (int32_t)expiry;
+    atomic_store_explicit(&chunk->usage[slot], 0, memory_order_relaxed);
+    chunk->flags[slot] = FLAG_REGISTERED | (is_vip ? FLAG_VIP : 0) | (uint8_t)(discount << FLAG_DISCOUNT_SHIFT);
+    return 0;
+}
+
+// Dopisanie przejścia na koniec dziennika bramki
+static void log_pass(PassLog* log, int ticket_id, sim_time_t now) {
+    if (!log->tail || log->tail->used == REGISTRY_LOG_CHUNK) {
+        PassBlock* block = malloc(sizeof(PassBlock));
+        if (!block) {
+            return; // Przejście liczone, ale bez wpisu
+        }
+        block->next = NULL;
+        block->used = 0;
+        if (log->tail) {
+            log->tail->next = block;
+        } else {
+            log->head = block;
+        }
+        log->tail = block;
+    }
+    log->tail->passes[log->tail->used++] = (GatePass){ (uint32_t)now, ticket_id };
+}
+
+// Sprawdzenie biletu na bramce jednym odczytem rejestru; ważny bilet zapisuje przejście
+PassResult registry_validate(int gate_id, int ticket_id, sim_time_t now) {
+    PassLog* log = &logs[gate_id];
+    RegistryChunk* chunk = registry_chunk(ticket_id, false);
+    int slot = ticket_id % REGISTRY_CHUNK;
+    if (!chunk || !(chunk->flags[slot] & FLAG_REGISTERED)) {
+        atomic_fetch_add_explicit(&log->rejected, 1, memory_order_relaxed);
+        return PASS_UNKNOWN;
+    }
+    if (now >= chunk->expiry[slot]) {
+        atomic_fetch_add_explicit(&log->rejected, 1, memory_order_relaxed);
+        return PASS_EXPIRED;
+    }
+
+    atomic_fetch_add_explicit(&chunk->usage[slot], 1, memory_order_relaxed);
+    log_pass(log, ticket_id, now);
+    atomic_fetch_add_explicit(&log->passes, 1, memory_order_relaxed);
+    return PASS_OK;
+}
+
+// Liczba przejść na bilecie
+int registry_usage(int ticket_id) {
+    RegistryChunk* chunk = registry_chunk(ticket_id, false);
+    return chunk ? atomic_load(&chunk->usage[ticket_id % REGISTRY_CHUNK]) : 0;
+}
+
+long registry_gate_passes(int gate_id) {
+    return atomic_load(&logs[gate_id].passes);
+}
+
+// Raport dzienników bramek
+void registry_print_report(void) {
+    printf("\n[Raport kontroli biletow]\n");
+    for (int i = 0; i < num_logs; i++) {
+        PassLog* log = &logs[i];
+        uint32_t first = log->head && log->head->used > 0 ? log->head->passes[0].time : 0;
+        uint32_t last = log->tail && log->tail->used > 0 ? log->tail->passes[log->tail->used - 1].time : 0;
+        printf("- Bramka #%d: skasowane bilety %ld, odrzucone %ld, pierwsze przejscie %u s, ostatnie %u s.\n",
+               i, atomic_load(&log->passes), atomic_load(&log->rejected), first, last);
+    }
+}
@@ -0,0 +1,41 @@
+#ifndef REGISTRY_H
+#define REGISTRY_H
+
+#include <stdbool.h>
+#include <stdint.h>
+#include "des.h"
+
+#define REGISTRY_CHUNK 4096       // Biletów w jednym bloku rejestru
+#define REGISTRY_MAX_CHUNKS 4096  // Maksymalnie REGISTRY_CHUNK * REGISTRY_MAX_CHUNKS biletów
+#define REGISTRY_LOG_CHUNK 4096   // Wpisów w jednym bloku dziennika bramki
+
+// Klasa zniżki biletu
+typedef enum {
+    DISCOUNT_NONE,
+    DISCOUNT_CHILD,   // Poniżej 12 lat
+    DISCOUNT_SENIOR   // Powyżej 65 lat
+} DiscountClass;
+
+// Wynik sprawdzenia biletu na bramce
+typedef enum {
+    PASS_OK,
+    PASS_EXPIRED,   // Bilet stracił ważność
+    PASS_UNKNOWN    // Brak biletu w rejestrze
+} PassResult;
+
+// Wpis dziennika przejść bramki
+typedef struct {
+    uint32_t time;      // Czas symulowany przejścia (w sekundach od otwarcia)
+    int32_t ticket_id;
+} GatePass;
+
+// Funkcje rejestru biletów
+int registry_init(int num_gates);
+void registry_destroy(void);
+int registry_add(int ticket_id, sim_time_t expiry, bool is_vip, DiscountClass discount);
+PassResult registry_validate(int gate_id, int ticket_id, sim_time_t now);
+int registry_usage(int ticket_id);
+long registry_gate_passes(int gate_id);
+void registry_print_report(void);
+
+#endif
@@ -0,0 +1,335 @@
+#include <fcntl.h>
+#include <stdbool.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include "trace.h"
+#include "config.h"
+
+// Analiza zapisanego śladu bez ponownej symulacji: agregaty, przebieg długości kolejek w czasie
+// i historia pojedynczego narciarza. Sumy czasów liczone są jako różnice sum końców i początków
+// etapów, więc wynik nie zależy od kolejności rekordów zapisanych przez różne wątki.
+
+#define REPLAY_DAY_SECONDS 86400LL  // Przesunięcie czasu kolejnych dni
+#define REPLAY_MAX_EVENTS 4096      // Limit zdarzeń wypisywanych dla jednego narciarza
+
+// Liczniki w jednym przedziale przebiegu czasowego (zmiany, po zsumowaniu stany)
+typedef struct {
+    int gates;
+    int before_platform;
+    int platform;
+    int chairs;
+    int trails;
+} ReplayGauge;
+
+// Suma początków i końców etapu
+typedef struct {
+    long long started;
+    long long ended;
+    long count;
+} ReplayStage;
+
+static const char* type_names[TRACE_TYPES] = {
+    [TRACE_NONE]        = "-",
+    [TRACE_TICKET]      = "Zakup biletu",
+    [TRACE_GATE_QUEUE]  = "Kolejka do bramki",
+    [TRACE_GATE_PASS]   = "Przejscie przez bramke",
+    [TRACE_REJECTED]    = "Odrzucony bilet",
+    [TRACE_CLOSED]      = "Stacja zamknieta",
+    [TRACE_PLATFORM]    = "Wejscie na peron",
+    [TRACE_BOARD]       = "Wejscie na krzeselko",
+    [TRACE_ALIGHT]      = "Zejscie z krzeselka",
+    [TRACE_TRAIL]       = "Wybor trasy",
+    [TRACE_DESCENT_END] = "Koniec zjazdu",
+    [TRACE_DONE]        = "Koniec dnia",
+    [TRACE_LIFT_STOP]   = "Zatrzymanie kolejki",
+    [TRACE_LIFT_RESUME] = "Wznowienie kolejki",
+};
+
+static const TraceHeader* header;
+static const TraceRecord* records;
+static long long record_count;
+
+static void usage(const char* program) {
+    fprintf(stderr, "Uzycie: %s plik_sladu [--timeline sekundy] [--lift N] [--skier ID]\n", program);
+}
+
+// Odwzorowanie pliku śladu tylko do odczytu
+static int replay_open(const char* path) {
+    int fd = open(path, O_RDONLY);
+    if (fd == -1) {
+        return -1;
+    }
+    struct stat st;
+    if (fstat(fd, &st) == -1 || st.st_size < TRACE_HEADER_SIZE) {
+        close(fd);
+        return -1;
+    }
+    void* area = mmap(NULL, st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+    close(fd);
+    if (area == MAP_FAILED) {
+        return -1;
+    }
+    header = area;
+    if (memcmp(header->magic, TRACE_MAGIC, sizeof(header->magic)) != 0 || header->record_size != sizeof(TraceRecord) ||
+        header->num_lifts <= 0) {
+        return -1;
+    }
+    records = (const TraceRecord*)((const char*)area + TRACE_HEADER_SIZE);
+    record_count = (st.st_size - TRACE_HEADER_SIZE) / (long long)sizeof(TraceRecord);
+    if (record_count > header->count) {
+        record_count = header->count;
+    }
+    return 0;
+}
+
+static long long absolute_time(const TraceRecord* record) {
+    return (record->day - 1) * REPLAY_DAY_SECONDS + record->time;
+}
+
+// Kolejka, z której ruszyła trasa (koniec zjazdu zapisuje kolejkę docelową)
+static int trail_origin(const TraceRecord* record) {
+    int lifts = header->num_lifts;
+    return record->type == TRACE_DESCENT_END ? ((record->lift - record->arg) % lifts + lifts) % lifts : record->lift;
+}
+
+// Trasa albo kolejka spoza zakresu (uszkodzony plik) przekroczyłaby tablice statystyk tras
+static bool bad_trail(const TraceRecord* record) {
+    return (record->type == TRACE_TRAIL || record->type == TRACE_DESCENT_END) &&
+           (record->arg < 0 || record->arg >= CONFIG_TRACKS || record->lift >= header->num_lifts);
+}
+
+static void print_time(long long seconds) {
+    printf("%02lld:%02lld:%02lld", header->opening_hour + seconds / 3600, (seconds / 60) % 60, seconds % 60);
+}
+
+static double stage_mean(const ReplayStage* stage) {
+    return stage->count > 0 ? (double)(stage->ended - stage->started) / stage->count : 0.0;
+}
+
+// Agregaty całego śladu
+static void print_aggregates(int lift_filter) {
+    long counts[TRACE_TYPES] = { 0 };
+    int days = 0;
+    int max_skier = -1;
+    ReplayStage gate = { 0 }, entry = { 0 }, chair = { 0 }, ride = { 0 }, stops = { 0 };
+    int trail_count = header->num_lifts * CONFIG_TRACKS;
+    ReplayStage* trails = calloc(trail_count, sizeof(ReplayStage));
+    if (!trails) {
+        fprintf(stderr, "Blad: Brak pamieci na statystyki tras.\n");
+        return;
+    }
+
+    for (long long i = 0; i < record_count; i++) {
+        const TraceRecord* record = &records[i];
+        if (record->type == TRACE_NONE || record->type >= TRACE_TYPES || record->day == 0 || bad_trail(record)) {
+            continue;
+        }
+        int lift = record->type == TRACE_TRAIL || record->type == TRACE_DESCENT_END ? trail_origin(record) : record->lift;
+        if (lift_filter >= 0 && lift != lift_filter) {
+            continue;
+        }
+        long long t = absolute_time(record);
+        counts[record->type]++;
+        if (record->day > days) {
+            days = record->day;
+        }
+        if (record->skier_id > max_skier) {
+            max_skier = record->skier_id;
+        }
+        switch (record->type) {
+        case TRACE_GATE_QUEUE:  gate.started += t; break;
+        case TRACE_GATE_PASS:   gate.ended += t; gate.count++; entry.started += t; break;
+        case TRACE_REJECTED:    gate.ended += t; gate.count++; break;
+        case TRACE_CLOSED:      entry.ended += t; entry.count++; break;
+        case TRACE_PLATFORM:    entry.ended += t; entry.count++; chair.started += t; break;
+        case TRACE_BOARD:       chair.ended += t; chair.count++; ride.started += t; break;
+        case TRACE_ALIGHT:      ride.ended += t; ride.count++; break;
+        case TRACE_TRAIL:       trails[lift * CONFIG_TRACKS + record->arg].started += t; break;
+        case TRACE_DESCENT_END: trails[lift * CONFIG_TRACKS + record->arg].ended += t;
+                                trails[lift * CONFIG_TRACKS + record->arg].count++; break;
+        case TRACE_LIFT_STOP:   stops.started += t; break;
+        case TRACE_LIFT_RESUME: stops.ended += t; stops.count++; break;
+        default: break;
+        }
+    }
+
+    long events = 0;
+    for (int type = TRACE_TICKET; type < TRACE_TYPES; type++) {
+        events += counts[type];
+    }
+    printf("[Raport sladu]\n");
+    printf("- Zdarzenia: %ld (miejsca w pliku: %lld), dni: %d, narciarze: %d, kolejki: %d.\n", events, record_count,
+           days, max_skier + 1, header->num_lifts);
+    for (int type = TRACE_TICKET; type < TRACE_TYPES; type++) {
+        printf("  %-24s %ld\n", type_names[type], counts[type]);
+    }
+    printf("- Srednie oczekiwanie na bramke: %.1f s (%ld przejsc).\n", stage_mean(&gate), gate.count);
+    printf("- Srednie oczekiwanie na miejsce na peronie: %.1f s.\n", stage_mean(&entry));
+    printf("- Srednie oczekiwanie na krzeselko: %.1f s (%ld wejsc).\n", stage_mean(&chair), chair.count);
+    printf("- Sredni przejazd krzeselkiem: %.1f s.\n", stage_mean(&ride));
+    printf("- Zatrzymania kolejki: %ld, srednio %.1f s.\n", stops.count, stage_mean(&stops));
+    for (int i = 0; i < trail_count; i++) {
+        if (trails[i].count > 0) {
+            printf("- Trasa T%d z kolejki #%d: zjazdy %ld, srednio %.1f s.\n", i % CONFIG_TRACKS + 1,
+                   i / CONFIG_TRACKS, trails[i].count, stage_mean(&trails[i]));
+        }
+    }
+    free(trails);
+}
+
+// Przebieg liczby narciarzy na każdym etapie, próbkowany co bucket sekund
+static void print_timeline(int bucket, int lift_filter) {
+    int days = 0;
+    long long max_time = 0;
+    for (long long i = 0; i < record_count; i++) {
+        if (records[i].type != TRACE_NONE && records[i].type < TRACE_TYPES) {
+            days = records[i].day > days ? records[i].day : days;
+            max_time = records[i].time > max_time ? records[i].time : max_time;
+        }
+    }
+    int buckets = (int)(max_time / bucket) + 1;
+    ReplayGauge* gauges = calloc((size_t)days * buckets, sizeof(ReplayGauge));
+    if (!gauges) {
+        fprintf(stderr, "Blad: Brak pamieci na przebieg czasowy.\n");
+        return;
+    }
+
+    for (long long i = 0; i < record_count; i++) {
+        const TraceRecord* record = &records[i];
+        if (record->type == TRACE_NONE || record->type >= TRACE_TYPES || record->day == 0 || bad_trail(record)) {
+            continue;
+        }
+        int lift = record->type == TRACE_TRAIL || record->type == TRACE_DESCENT_END ? trail_origin(record) : record->lift;
+        if (lift_filter >= 0 && lift != lift_filter) {
+            continue;
+        }
+        ReplayGauge* gauge = &gauges[(size_t)(record->day - 1) * buckets + record->time / bucket];
+        switch (record->type) {
+        case TRACE_GATE_QUEUE:  gauge->gates++; break;
+        case TRACE_GATE_PASS:   gauge->gates--; gauge->before_platform++; break;
+        case TRACE_REJECTED:    gauge->gates--; break;
+        case TRACE_CLOSED:      gauge->before_platform--; break;
+        case TRACE_PLATFORM:    gauge->before_platform--; gauge->platform++; break;
+        case TRACE_BOARD:       gauge->platform--; gauge->chairs++; break;
+        case TRACE_ALIGHT:      gauge->chairs--; break;
+        case TRACE_TRAIL:       gauge->trails++; break;
+        case TRACE_DESCENT_END: gauge->trails--; break;
+        default: break;
+        }
+    }
+
+    for (int day = 0; day < days; day++) {
+        printf("\n[Dzien %d] %-8s %8s %12s %8s %10s %8s\n", day + 1, "Czas", "Bramki", "Przed peronem", "Peron",
+               "Krzeselka", "Trasy");
+        ReplayGauge state = { 0 };
+        for (int b = 0; b < buckets; b++) {
+            const ReplayGauge* delta = &gauges[(size_t)day * buckets + b];
+            state.gates += delta->gates;
+            state.before_platform += delta->before_platform;
+            state.platform += delta->platform;
+            state.chairs += delta->chairs;
+            state.trails += delta->trails;
+            printf("          ");
+            print_time((long long)(b + 1) * bucket);
+            printf(" %8d %12d %8d %10d %8d\n", state.gates, state.before_platform, state.platform, state.chairs,
+                   state.trails);
+        }
+    }
+    free(gauges);
+}
+
+// Zdarzenia o tym samym czasie zostają w kolejności zapisu (w obrębie wątku jest ona przyczynowa)
+static int compare_events(const void* x, const void* y) {
+    const TraceRecord* a = *(const TraceRecord* const*)x;
+    const TraceRecord* b = *(const TraceRecord* const*)y;
+    long long ta = absolute_time(a);
+    long long tb = absolute_time(b);
+    if (ta != tb) {
+        return (ta > tb) - (ta < tb);
+    }
+    return (a > b) - (a < b);
+}
+
+// Historia jednego narciarza w kolejności czasu
+static void print_skier(int skier_id) {
+    const TraceRecord** events = malloc(sizeof(TraceRecord*) * REPLAY_MAX_EVENTS);
+    if (!events) {
+        fprintf(stderr, "Blad: Brak pamieci na historie narciarza.\n");
+        return;
+    }
+    int count = 0;
+    for (long long i = 0; i < record_count && count < REPLAY_MAX_EVENTS; i++) {
+        if (records[i].type != TRACE_NONE && records[i].skier_id == skier_id) {
+            events[count++] = &records[i];
+        }
+    }
+    qsort(events, count, sizeof(TraceRecord*), compare_events);
+
+    printf("\n[Historia narciarza #%d]\n", skier_id);
+    for (int i = 0; i < count; i++) {
+        const TraceRecord* event = events[i];
+        printf("Dzien %d ", event->day);
+        print_time(event->time);
+        printf(" kolejka #%d: %s", event->lift, type_names[event->type]);
+        switch (event->type) {
+        case TRACE_TICKET:      printf(" (typ %d%s)", event->arg & 0xff, event->arg >= 256 ? ", VIP" : ""); break;
+        case TRACE_GATE_QUEUE:
+        case TRACE_GATE_PASS:
+        case TRACE_REJECTED:
+        case TRACE_CLOSED:      printf(" (bramka #%d)", event->arg); break;
+        case TRACE_TRAIL:
+        case TRACE_DESCENT_END: printf(" T%d", event->arg + 1); break;
+        default: break;
+        }
+        putchar('\n');
+    }
+    if (count == 0) {
+        printf("Brak zdarzen tego narciarza.\n");
+    }
+    free(events);
+}
+
+int main(int argc, char* argv[]) {
+    if (argc < 2) {
+        usage(argv[0]);
+        return 1;
+    }
+    int bucket = 0;
+    bool timeline = false;
+    int lift_filter = -1;
+    int skier_id = -1;
+    for (int i = 2; i < argc; i++) {
+        if (strcmp(argv[i], "--timeline") == 0 && i + 1 < argc) {
+            bucket = atoi(argv[++i]);
+            timeline = true;
+        } else if (strcmp(argv[i], "--lift") == 0 && i + 1 < argc) {
+            lift_filter = atoi(argv[++i]);
+        } else if (strcmp(argv[i], "--skier") == 0 && i + 1 < argc) {
+            skier_id = atoi(argv[++i]);
+        } else {
+            usage(argv[0]);
+            return 1;
+        }
+    }
+    if (timeline && bucket <= 0) {
+        fprintf(stderr, "Blad: Przedzial przebiegu czasowego musi byc dodatni.\n");
+        return 1;
+    }
+    if (replay_open(argv[1]) == -1) {
+        fprintf(stderr, "Blad: Nie udalo sie odczytac sladu %s.\n", argv[1]);
+        return 1;
+    }
+
+    print_aggregates(lift_filter);
+    if (timeline) {
+        print_timeline(bucket, lift_filter);
+    }
+    if (skier_id >= 0) {
+        print_skier(skier_id);
+    }
+    return 0;
+}
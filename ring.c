@@ -0,0 +1,62 @@
+#include "ring.h"
+#include "futex.h"
+#include "lockstat.h"
+#include <time.h>
+
+// Uśpienie do zmiany licznika; flaga jest ustawiana przed ponownym sprawdzeniem,
+// więc druga strona albo zobaczy flagę, albo my zobaczymy nową wartość
+static void wait_for_change(atomic_uint* counter, atomic_uint* sleeping, unsigned seen) {
+    while (atomic_load_explicit(counter, memory_order_acquire) == seen) {
+        atomic_store(sleeping, 1);
+        if (atomic_load(counter) == seen) {
+            WAIT_FUTEX(counter, seen, LOCK_RING, 0);
+        }
+        atomic_store(sleeping, 0);
+    }
+}
+
+static void wake_if_sleeping(atomic_uint* counter, atomic_uint* sleeping) {
+    if (atomic_load(sleeping) && atomic_exchange(sleeping, 0)) {
+        futex_wake(counter, 1);
+    }
+}
+
+void ring_init(ShmRing* ring) {
+    atomic_init(&ring->head, 0);
+    atomic_init(&ring->tail, 0);
+    atomic_init(&ring->consumer_sleeping, 0);
+    atomic_init(&ring->producer_sleeping, 0);
+}
+
+// Wysłanie komunikatu, przy pełnym pierścieniu czeka na konsumenta
+void ring_push(ShmRing* ring, const RingMessage* message) {
+    unsigned tail = atomic_load_explicit(&ring->tail, memory_order_relaxed);
+    unsigned head = atomic_load_explicit(&ring->head, memory_order_acquire);
+    while (tail - head == RING_CAPACITY) {
+        wait_for_change(&ring->head, &ring->producer_sleeping, head);
+        head = atomic_load_explicit(&ring->head, memory_order_acquire);
+    }
+    ring->slots[tail & (RING_CAPACITY - 1)] = *message;
+    atomic_store(&ring->tail, tail + 1);
+    wake_if_sleeping(&ring->tail, &ring->consumer_sleeping);
+}
+
+// Odebranie komunikatu, przy pustym pierścieniu czeka na producenta
+void ring_pop(ShmRing* ring, RingMessage* message) {
+    unsigned head = atomic_load_explicit(&ring->head, memory_order_relaxed);
+    unsigned tail = atomic_load_explicit(&ring->tail, memory_order_acquire);
+    while (tail == head) {
+        wait_for_change(&ring->tail, &ring->consumer_sleeping, tail);
+        tail = atomic_load_explicit(&ring->tail, memory_order_acquire);
+    }
+    *message = ring->slots[head & (RING_CAPACITY - 1)];
+    atomic_store(&ring->head, head + 1);
+    wake_if_sleeping(&ring->head, &ring->producer_sleeping);
+}
+
+// Czas monotoniczny w nanosekundach (wspólny dla wszystkich procesów)
+uint64_t ring_clock_ns(void) {
+    struct timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return (uint64_t)now.tv_sec * 1000000000ULL + (uint64_t)now.tv_nsec;
+}
@@ -0,0 +1,32 @@
+#ifndef RING_H
+#define RING_H
+
+#include <stdatomic.h>
+#include <stdint.h>
+
+#define RING_CAPACITY 64 // Komunikatów w jednym pierścieniu (potęga dwójki)
+
+// Komunikat przesyłany między procesami
+typedef struct {
+    int32_t type;
+    int32_t sender;
+    uint64_t value;   // Dane zależne od typu (np. czas w nanosekundach)
+} RingMessage;
+
+// Pierścień jednego producenta i jednego konsumenta w pamięci dzielonej.
+// Strona, która nie może kontynuować, śpi na futeksie licznika drugiej strony.
+typedef struct {
+    _Alignas(64) atomic_uint head;       // Następny komunikat do odczytu (konsument)
+    atomic_uint consumer_sleeping;       // Konsument czeka na nowy komunikat
+    _Alignas(64) atomic_uint tail;       // Następne wolne miejsce (producent)
+    atomic_uint producer_sleeping;       // Producent czeka na wolne miejsce
+    _Alignas(64) RingMessage slots[RING_CAPACITY];
+} ShmRing;
+
+// Funkcje pierścienia (pierścień musi leżeć w pamięci MAP_SHARED)
+void ring_init(ShmRing* ring);
+void ring_push(ShmRing* ring, const RingMessage* message);
+void ring_pop(ShmRing* ring, RingMessage* message);
+uint64_t ring_clock_ns(void);
+
+#endif
@@ -0,0 +1,55 @@
+#include "rng.h"
+
+static uint64_t base_seed = 0; // Ziarno całej symulacji (--seed)
+
+static uint64_t rotl(uint64_t x, int k) {
+    return (x << k) | (x >> (64 - k));
+}
+
+// SplitMix64: rozprasza ziarno na stan generatora
+static uint64_t splitmix64(uint64_t* state) {
+    uint64_t z = (*state += 0x9E3779B97F4A7C15ULL);
+    z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+    z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+    return z ^ (z >> 31);
+}
+
+void rng_set_seed(uint64_t seed) {
+    base_seed = seed;
+}
+
+uint64_t rng_get_seed(void) {
+    return base_seed;
+}
+
+// Strumień wyznaczony wyłącznie przez ziarno i numer strumienia (nie przez kolejność wątków)
+void rng_init(Rng* rng, uint64_t stream) {
+    uint64_t state = base_seed;
+    uint64_t mixed = splitmix64(&state) ^ (stream * 0xD1B54A32D192ED03ULL);
+    for (int i = 0; i < 4; i++) {
+        rng->s[i] = splitmix64(&mixed);
+    }
+}
+
+uint64_t rng_next(Rng* rng) {
+    uint64_t* s = rng->s;
+    uint64_t result = rotl(s[1] * 5, 7) * 9;
+    uint64_t t = s[1] << 17;
+    s[2] ^= s[0];
+    s[3] ^= s[1];
+    s[1] ^= s[2];
+    s[0] ^= s[3];
+    s[2] ^= t;
+    s[3] = rotl(s[3], 45);
+    return result;
+}
+
+// Liczba z przedziału [0, bound) metodą mnożenia (bez dzielenia modulo)
+int rng_below(Rng* rng, int bound) {
+    return (int)(((rng_next(rng) >> 32) * (uint64_t)bound) >> 32);
+}
+
+// Liczba z przedziału [0, 1)
+double rng_unit(Rng* rng) {
+    return (rng_next(rng) >> 11) * 0x1.0p-53;
+}
@@ -0,0 +1,25 @@
+#ifndef RNG_H
+#define RNG_H
+
+#include <stdint.h>
+
+// Numery strumieni: każdy podmiot losuje z własnego, niezależnego strumienia
+#define RNG_STREAM_ARRIVALS 1            // Przybycia narciarzy
+#define RNG_STREAM_SWEEP 2               // Losowanie punktów przeglądu parametrów (ski_sweep)
+#define RNG_STREAM_WORKER 16             // + ID pracownika
+#define RNG_STREAM_SKIER (1ULL << 32)    // + ID narciarza
+
+// Generator xoshiro256** (stan 256 bitów, niezależny od wątków)
+typedef struct {
+    uint64_t s[4];
+} Rng;
+
+// Funkcje generatora
+void rng_set_seed(uint64_t seed);
+uint64_t rng_get_seed(void);
+void rng_init(Rng* rng, uint64_t stream);
+uint64_t rng_next(Rng* rng);
+int rng_below(Rng* rng, int bound);
+double rng_unit(Rng* rng);
+
+#endif
@@ -0,0 +1,168 @@
+#include "slope.h"
+#include "lockstat.h"
+#include <stdio.h>
+#include <stdlib.h>
+
+#define SLOPE_INITIAL_CAPACITY 64
+
+static pthread_mutex_t slope_mutex = PTHREAD_MUTEX_INITIALIZER;
+static SlopeLane* lanes;
+static int num_lanes;
+static int on_slopes;          // Narciarze na wszystkich trasach
+static bool ticking;           // Czy ruch narciarzy jest zaplanowany
+static double ticked_seconds;  // Czas, przez który na trasach byli narciarze
+
+// Prędkość swobodna wynika z czasu przejazdu pustej trasy, a pojemność z jej długości
+int slopes_init(const Trail* trails, int count) {
+    slopes_destroy();
+    lanes = calloc(count, sizeof(SlopeLane));
+    if (!lanes) {
+        return -1;
+    }
+    num_lanes = count;
+    for (int i = 0; i < count; i++) {
+        float free_time = (float)trails[i].time * config.sim_seconds_per_step;
+        lanes[i].free_speed = 1.0f / free_time;
+        lanes[i].jam_count = config.trail_density * free_time / 60.0f;
+    }
+    return 0;
+}
+
+void slopes_destroy(void) {
+    for (int i = 0; i < num_lanes; i++) {
+        free(lanes[i].position);
+        free(lanes[i].pace);
+        free(lanes[i].skiers);
+    }
+    free(lanes);
+    lanes = NULL;
+    num_lanes = 0;
+    on_slopes = 0;
+    ticking = false;
+    ticked_seconds = 0;
+}
+
+static int lane_grow(SlopeLane* lane) {
+    int capacity = lane->capacity ? lane->capacity * 2 : SLOPE_INITIAL_CAPACITY;
+    float* position = realloc(lane->position, sizeof(float) * capacity);
+    if (!position) {
+        return -1;
+    }
+    lane->position = position;
+    float* pace = realloc(lane->pace, sizeof(float) * capacity);
+    if (!pace) {
+        return -1;
+    }
+    lane->pace = pace;
+    Skier** skiers = realloc(lane->skiers, sizeof(Skier*) * capacity);
+    if (!skiers) {
+        return -1;
+    }
+    lane->skiers = skiers;
+    lane->capacity = capacity;
+    return 0;
+}
+
+// Narciarz rozpoczyna zjazd; zwraca 1, gdy trzeba zaplanować ruch narciarzy, -1 przy braku pamięci
+int slope_enter(int trail_id, Skier* skier, float pace) {
+    SlopeLane* lane = &lanes[trail_id];
+    LOCK_MUTEX(&slope_mutex, LOCK_SLOPE, 0);
+    if (lane->count == lane->capacity && lane_grow(lane) == -1) {
+        pthread_mutex_unlock(&slope_mutex);
+        fprintf(stderr, "Blad: Nie udalo sie powiekszyc trasy T%d.\n", trail_id % CONFIG_TRACKS + 1);
+        return -1;
+    }
+    lane->position[lane->count] = 0.0f;
+    lane->pace[lane->count] = pace;
+    lane->skiers[lane->count] = skier;
+    lane->count++;
+    if (lane->count > lane->peak) {
+        lane->peak = lane->count;
+    }
+    on_slopes++;
+    int start = !ticking;
+    ticking = true;
+    pthread_mutex_unlock(&slope_mutex);
+    return start;
+}
+
+// Prędkość maleje liniowo z zagęszczeniem (model Greenshieldsa) do progu minimalnego
+static float lane_speed(const SlopeLane* lane) {
+    float factor = 1.0f - (float)lane->count / lane->jam_count;
+    float min_factor = config.min_trail_speed / 100.0f;
+    return lane->free_speed * (factor > min_factor ? factor : min_factor);
+}
+
+// Przesunięcie narciarzy jednej trasy i odłączenie tych, którzy dojechali na dół
+static Skier* lane_advance(SlopeLane* lane, sim_time_t now, float dt, Skier* finished) {
+    float step = lane_speed(lane) * dt;
+    float* restrict position = lane->position;
+    const float* restrict pace = lane->pace;
+    int count = lane->count;
+    for (int i = 0; i < count; i++) {
+        position[i] += pace[i] * step;
+    }
+
+    // Usunięcie przez zamianę z ostatnim, kolejność na trasie nie ma znaczenia
+    for (int i = count - 1; i >= 0; i--) {
+        if (position[i] < 1.0f) {
+            continue;
+        }
+        Skier* skier = lane->skiers[i];
+        lane->descent_seconds += now - skier->stage_at;
+        lane->finished++;
+        count--;
+        position[i] = position[count];
+        lane->pace[i] = lane->pace[count];
+        lane->skiers[i] = lane->skiers[count];
+        skier->next = finished;
+        finished = skier;
+    }
+    lane->count = count;
+    return finished;
+}
+
+// Krok ruchu na wszystkich trasach; zwraca listę narciarzy, którzy ukończyli zjazd (przez pole next).
+// active mówi, czy trzeba zaplanować kolejny krok.
+Skier* slopes_advance(sim_time_t now, sim_time_t dt, bool* active) {
+    Skier* finished = NULL;
+    LOCK_MUTEX(&slope_mutex, LOCK_SLOPE, 0);
+    if (on_slopes > 0) {
+        ticked_seconds += dt;
+    }
+    for (int i = 0; i < num_lanes; i++) {
+        SlopeLane* lane = &lanes[i];
+        lane->occupancy_seconds += (double)lane->count * dt;
+        int before = lane->count;
+        finished = lane_advance(lane, now, (float)dt, finished);
+        on_slopes -= before - lane->count;
+    }
+    ticking = on_slopes > 0;
+    *active = ticking;
+    pthread_mutex_unlock(&slope_mutex);
+    return finished;
+}
+
+int slopes_skier_count(void) {
+    LOCK_MUTEX(&slope_mutex, LOCK_SLOPE, 0);
+    int count = on_slopes;
+    pthread_mutex_unlock(&slope_mutex);
+    return count;
+}
+
+// Raport ruchu na trasach: obłożenie i wydłużenie zjazdów przez zatłoczenie
+void slopes_print_report(const Trail* trails) {
+    LOCK_MUTEX(&slope_mutex, LOCK_SLOPE, 0);
+    printf("\n[Raport tras]\n");
+    for (int i = 0; i < num_lanes; i++) {
+        const SlopeLane* lane = &lanes[i];
+        const Trail* trail = &trails[i];
+        double free_time = (double)trail->time * config.sim_seconds_per_step;
+        double mean_time = lane->finished > 0 ? lane->descent_seconds / lane->finished : 0.0;
+        printf("- Trasa T%d z kolejki #%d do kolejki #%d: zjazdy %ld, srednio %.0f s (swobodnie %.0f s), "
+               "obsada srednia %.1f, szczyt %d.\n", i % CONFIG_TRACKS + 1, trail->from_lift, trail->to_lift,
+               trail->descents, mean_time, free_time,
+               ticked_seconds > 0 ? lane->occupancy_seconds / ticked_seconds : 0.0, lane->peak);
+    }
+    pthread_mutex_unlock(&slope_mutex);
+}
@@ -0,0 +1,32 @@
+#ifndef SLOPE_H
+#define SLOPE_H
+
+#include "station.h"
+
+#define SLOPE_TICK 10 // Krok ruchu narciarzy na trasach (w sekundach symulowanych)
+
+// Narciarze jednej trasy w układzie struktury tablic: pozycje i tempa w osobnych ciągłych tablicach,
+// więc przesunięcie wszystkich narciarzy trasy to jedna pętla wektoryzowana przez kompilator
+typedef struct {
+    float* position;          // Przebyta część trasy (0-1)
+    float* pace;              // Tempo narciarza względem przeciętnego
+    Skier** skiers;
+    int count;                // Narciarze na trasie
+    int capacity;             // Pojemność tablic
+    float free_speed;         // Część trasy na sekundę symulowaną przy pustej trasie
+    float jam_count;          // Liczba narciarzy, przy której trasa jest zakorkowana (prędkość zerowa bez progu)
+    long finished;            // Ukończone zjazdy
+    double descent_seconds;   // Łączny czas ukończonych zjazdów
+    double occupancy_seconds; // Całka liczby narciarzy po czasie (średnie obłożenie)
+    int peak;                 // Największa liczba narciarzy jednocześnie
+} SlopeLane;
+
+// Funkcje tras z zatłoczeniem (własny mutex modułu)
+int slopes_init(const Trail* trails, int count);
+void slopes_destroy(void);
+int slope_enter(int trail_id, Skier* skier, float pace);
+Skier* slopes_advance(sim_time_t now, sim_time_t dt, bool* active);
+int slopes_skier_count(void);
+void slopes_print_report(const Trail* trails);
+
+#endif
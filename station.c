@@ -0,0 +1,867 @@
+#include "station.h"
+#include "lift.h"
+#include "gate.h"
+#include "log.h"
+#include "ledger.h"
+#include "hist.h"
+#include "arena.h"
+#include "registry.h"
+#include "futex.h"
+#include "lockstat.h"
+#include "board.h"
+#include "slope.h"
+#include "trace.h"
+#include "usage.h"
+#include "arrivals.h"
+#include <limits.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define DAY_LENGTH ((config.closing_hour - config.opening_hour) * 3600) // Długość dnia w sekundach symulowanych
+#define GATE_RETRY_DELAY 10 // Ponowna próba wejścia, gdy wszystkie kolejki do bramek są pełne
+
+// Kolejka z własnym peronem, bramkami i krzesełkami; każda na osobnych liniach pamięci podręcznej,
+// więc kolejki nie rywalizują o wspólny mutex ani o te same linie
+typedef struct {
+    _Alignas(CACHE_LINE) pthread_mutex_t mutex; // Chroni peron, planistę wsiadania i krzesełka
+    SkierQueue platform_queue;  // Oczekujący na miejsce na peronie
+    BoardScheduler boarding;    // Na peronie, oczekujący na krzesełko
+    ChairLift lift;             // Pierścień krzesełek
+    int on_platform;            // Narciarze na peronie
+    int on_chairs;              // Narciarze na krzesełkach
+    int platform_waiting;       // Narciarze w platform_queue (z członkami grup)
+    long stops;                 // Zatrzymania kolejki przez pracownika
+    bool tick_scheduled;        // Czy kolejny ruch liny jest zaplanowany
+    sim_time_t stopped_at;      // Chwila ostatniego zatrzymania kolejki
+    int lift_id;
+    _Alignas(CACHE_LINE) atomic_uint state; // Flagi LIFT_* i epoka (zapis pod mutex)
+} LiftShard;
+
+// Symulowany czas
+volatile int simulated_time = 0;
+volatile bool is_station_open = true;
+
+// Mutexy i zmienne warunkowe
+pthread_mutex_t station_mutex = PTHREAD_MUTEX_INITIALIZER;
+static pthread_cond_t station_closed_cond = PTHREAD_COND_INITIALIZER;
+
+static const Scheduler* sched;
+static int next_skier_id;
+static int active_skiers;          // Narciarze, którzy nie zakończyli dnia (station_mutex)
+static StationStats stats;
+static int* gate_ids;              // Argumenty zadań bramek
+static long open_seconds;          // Łączny czas otwarcia stacji
+static int skier_limit;            // Limit utworzonych narciarzy (0: bez limitu)
+static sim_time_t day_start;       // Chwila otwarcia stacji w bieżącym dniu
+static sim_time_t arrival_times[ARRIVALS_BATCH]; // Przybycia wygenerowane z wyprzedzeniem (od otwarcia)
+static int arrival_next;           // Pierwsze nieobsłużone przybycie w paczce
+static int arrival_count;          // Przybyć w paczce
+
+static LiftShard* shards;          // Kolejki (num_lifts)
+static int num_lifts;
+static Trail* trails;              // Trasy: CONFIG_TRACKS z górnej stacji każdej kolejki
+
+static void gate_task(void* arg);
+static void gate_retry_task(void* arg);
+static void lift_tick_task(void* arg);
+static void descent_end_task(void* arg);
+static void slope_tick_task(void* arg);
+
+// Zmiana flag kolejki w nowej epoce i obudzenie czekających na futeksie
+static void lift_transition(LiftShard* shard, unsigned clear, unsigned set) {
+    unsigned old = atomic_load(&shard->state);
+    unsigned state = ((old & ~(LIFT_EPOCH_STEP - 1)) + LIFT_EPOCH_STEP) | ((old & ~clear) & (LIFT_EPOCH_STEP - 1)) | set;
+    atomic_store(&shard->state, state);
+    futex_wake(&shard->state, INT_MAX);
+}
+
+static bool lift_is_running(const LiftShard* shard) {
+    return atomic_load_explicit(&shard->state, memory_order_relaxed) & LIFT_RUNNING;
+}
+
+// Funkcja obslugi dzieci i opiekunów: dziecko wchodzi na kolejkę tylko w grupie z opiekunem,
+// który ma pod opieką najwyżej GROUP_MAX_CHILDREN dzieci
+bool can_ski(Skier* skier) {
+    int children = 0;
+    for (const Skier* member = skier->group_next; member; member = member->group_next) {
+        children += member->is_child;
+    }
+    if (skier->is_child || (children > 0 && !skier->is_guardian)) {
+        log_event(EV_NO_GUARDIAN, skier->skier_id, 0);
+        return false;
+    }
+    if (children > GROUP_MAX_CHILDREN) { // Sprawdzanie liczby dzieci pod opieka
+        log_event(EV_GUARDIAN_FULL, skier->skier_id, 0);
+        return false;
+    }
+    return true;
+}
+
+// Narciarz w wieku z podanego przedziału; członek grupy przychodzi do kolejki prowadzącego
+static Skier* new_skier(int skier_id, int min_age, int ages, const Skier* leader) {
+
+    Skier* skier = skier_alloc();
+    if (!skier) { // Sprawdzenie alokacji
+        log_event(EV_SKIER_LOST, skier_id, 0);
+        return NULL;
+    }
+    memset(skier, 0, sizeof(Skier));
+    skier->skier_id = skier_id;
+    skier->group_size = 1;
+    rng_init(&skier->rng, RNG_STREAM_SKIER + (uint64_t)skier_id);
+    skier->age = rng_below(&skier->rng, ages) + min_age;
+    purchase_ticket(&skier->ticket, skier->skier_id, skier->age, &skier->rng);
+    skier->is_guardian = skier->age >= 18 && skier->age <= 65;
+    skier->is_child = skier->age >= 4 && skier->age <= 8;
+    if (leader) {
+        skier->lift = leader->lift;
+    } else {
+        skier->lift = num_lifts > 1 ? rng_below(&skier->rng, num_lifts) : 0; // Dolna stacja, do której przychodzi
+    }
+    trace_record(TRACE_TICKET, skier_id, skier->lift, skier->ticket.ticket_type + (skier->ticket.is_vip ? 256 : 0));
+    return skier;
+}
+
+// Utworzenie narciarza wraz z zakupem biletu
+Skier* create_skier(int skier_id) {
+    return new_skier(skier_id, 4, 75, NULL);
+}
+
+// Grupa przybywająca z narciarzem: opiekun z dziećmi albo znajomi. Grupa nie jest większa niż krzesełko,
+// więc zawsze może usiąść razem; dziecko samo grupy nie prowadzi
+static void form_group(Skier* leader) {
+    int seats = config.max_people_on_chair;
+    if (seats < 2 || leader->is_child || rng_below(&leader->rng, 100) >= config.group_share) {
+        return;
+    }
+    bool family = leader->is_guardian && rng_below(&leader->rng, 100) < config.family_share;
+    int max_members = family && seats - 1 > GROUP_MAX_CHILDREN ? GROUP_MAX_CHILDREN : seats - 1;
+    int members = 1 + rng_below(&leader->rng, max_members);
+    if (skier_limit > 0 && members > skier_limit - next_skier_id) {
+        members = skier_limit - next_skier_id;
+    }
+
+    Skier** tail = &leader->group_next;
+    for (int i = 0; i < members; i++) {
+        Skier* member = family ? new_skier(next_skier_id++, 4, 5, leader) : new_skier(next_skier_id++, 9, 70, leader);
+        if (!member) {
+            break;
+        }
+        member->leader = leader;
+        *tail = member;
+        tail = &member->group_next;
+        leader->group_size++;
+    }
+}
+
+// Zdarzenie śladu dla każdej osoby z grupy prowadzonej przez narciarza
+static void trace_group(TraceEventType type, const Skier* leader, int arg) {
+    for (const Skier* skier = leader; skier; skier = skier->group_next) {
+        trace_record(type, skier->skier_id, leader->lift, arg);
+    }
+}
+
+// Koniec etapu całej grupy: czas oczekiwania każdej osoby i początek kolejnego etapu
+static void group_stage(Skier* leader, SkierState state, HistStage stage, sim_time_t now) {
+    for (Skier* skier = leader; skier; skier = skier->group_next) {
+        hist_record(stage, now - skier->stage_at);
+        skier->stage_at = now;
+        skier->state = state;
+    }
+}
+
+static void group_set_state(Skier* leader, SkierState state) {
+    for (Skier* skier = leader; skier; skier = skier->group_next) {
+        skier->state = state;
+    }
+}
+
+// Zwolnienie rekordów narciarza i członków jego grupy
+static void free_group(Skier* skier) {
+    while (skier) {
+        Skier* next = skier->group_next;
+        skier_free(skier);
+        skier = next;
+    }
+}
+
+// Koniec dnia narciarza razem z jego grupą
+static void finish_skier(Skier* skier) {
+    int size = skier->group_size;
+    for (Skier* rider = skier; rider; rider = rider->group_next) {
+        log_event(EV_SKIER_DONE, rider->skier_id, 0);
+        trace_record(TRACE_DONE, rider->skier_id, rider->lift, 0);
+        rider->state = SKIER_DONE;
+    }
+    free_group(skier);
+
+    LOCK_MUTEX(&station_mutex, LOCK_STATION, 0);
+    active_skiers -= size;
+    if (!is_station_open && active_skiers == 0) {
+        pthread_cond_broadcast(&station_closed_cond);
+    }
+    pthread_mutex_unlock(&station_mutex);
+}
+
+// Narciarz (z grupą) ustawia się w kolejce do bramki dolnej stacji swojej kolejki i parkuje
+static void enter_gate(Skier* skier) {
+    int first_gate = skier->lift * config.num_gates;
+    int gate_id = gate_choose(&skier->rng, skier->lift);
+    int skier_id = skier->skier_id;
+    sim_time_t now = sched->now();
+    for (Skier* rider = skier; rider; rider = rider->group_next) {
+        rider->state = SKIER_AT_GATE;
+        rider->queued_at = now;
+        rider->stage_at = now;
+    }
+
+    // Pełna kolejka: narciarz próbuje pozostałych bramek, a gdy wszystkie są pełne, wraca później
+    int tries = 0;
+    while (!gate_enqueue(gate_id, skier)) {
+        if (++tries == config.num_gates) {
+            log_event(EV_GATES_FULL, skier_id, skier->lift);
+            sched->schedule(GATE_RETRY_DELAY, gate_retry_task, skier);
+            return;
+        }
+        gate_id = first_gate + (gate_id - first_gate + 1) % config.num_gates;
+    }
+    log_event(EV_GATE_ENTER, skier_id, gate_id);
+    trace_group(TRACE_GATE_QUEUE, skier, gate_id);
+
+    if (gate_try_activate(gate_id)) {
+        sched->schedule(0, gate_task, &gate_ids[gate_id]);
+    }
+}
+
+static void gate_retry_task(void* arg) {
+    enter_gate(arg);
+}
+
+// Czy narciarz z całą grupą zmieści się na peronie
+static bool platform_fits(const LiftShard* shard, const Skier* skier) {
+    return shard->on_platform + skier->group_size <= config.max_people_on_platform;
+}
+
+// Wejście na peron i oczekiwanie na krzesełko (wymaga mutexu kolejki)
+static void enter_platform_locked(LiftShard* shard, Skier* skier) {
+    shard->on_platform += skier->group_size;
+    for (Skier* rider = skier; rider; rider = rider->group_next) {
+        log_event(EV_PLATFORM_ENTER, rider->skier_id, 0);
+    }
+    trace_group(TRACE_PLATFORM, skier, 0);
+    group_stage(skier, SKIER_ON_PLATFORM, HIST_PLATFORM_WAIT, sched->now());
+
+    if (!lift_is_running(shard)) {
+        log_event(EV_WAIT_RESUME, skier->skier_id, 0);
+    } else if (!skier->ticket.is_vip) {
+        log_event(EV_WAIT_CHAIR, skier->skier_id, 0);
+    }
+    board_push(&shard->boarding, skier);
+}
+
+// Wejście na peron albo oczekiwanie na miejsce; kto przyjdzie, gdy inni już czekają, staje za nimi,
+// więc pojedynczy narciarze nie wyprzedzają grupy czekającej na kilka miejsc
+static void queue_for_platform_locked(LiftShard* shard, Skier* skier) {
+    if (shard->platform_queue.head || !platform_fits(shard, skier)) {
+        group_set_state(skier, SKIER_WAITING_FOR_PLATFORM);
+        skier_queue_push(&shard->platform_queue, skier);
+        shard->platform_waiting += skier->group_size;
+        return;
+    }
+    enter_platform_locked(shard, skier);
+}
+
+// Przejście grupy przez bramkę: kontrola biletów i wejście na dolny peron
+static void pass_gate(int gate_id, Skier* skier, bool stolen) {
+    if (stolen) {
+        log_event(EV_GATE_STEAL, gate_id, skier->skier_id);
+    }
+    sim_time_t now = sched->now();
+    group_stage(skier, SKIER_AT_GATE, HIST_GATE_WAIT, now);
+
+    // Grupa przechodzi razem: nieważny bilet jednej osoby zawraca całą grupę
+    bool valid = true;
+    for (Skier* rider = skier; rider; rider = rider->group_next) {
+        if (registry_validate(gate_id, rider->ticket.ticket_id, now) != PASS_OK) {
+            log_event(EV_TICKET_REJECTED, gate_id, rider->skier_id);
+            valid = false;
+        }
+    }
+    if (!valid) {
+        trace_group(TRACE_REJECTED, skier, gate_id);
+        finish_skier(skier);
+        return;
+    }
+    for (Skier* rider = skier; rider; rider = rider->group_next) {
+        log_event(EV_GATE_PASS, gate_id, rider->skier_id);
+    }
+    trace_group(TRACE_GATE_PASS, skier, gate_id);
+
+    // Stan stacji sprawdzany pod mutexem kolejki, tak jak przy ocenie opróżnienia peronu
+    LiftShard* shard = &shards[skier->lift];
+    LOCK_MUTEX(&shard->mutex, LOCK_SHARD, (int)(shard - shards));
+    bool is_open = is_station_open;
+    if (is_open) {
+        queue_for_platform_locked(shard, skier);
+    }
+    pthread_mutex_unlock(&shard->mutex);
+    if (!is_open) {
+        log_event(EV_GATE_CLOSED, skier->skier_id, 0);
+        trace_group(TRACE_CLOSED, skier, gate_id);
+        finish_skier(skier);
+    }
+}
+
+// Zadanie bramki: przepuszcza jednego narciarza na dolny peron. Następne zadanie tej bramki jest
+// planowane dopiero po zapisaniu przejścia, więc każda bramka ma co najwyżej jedno wykonywane zadanie
+// (jej dziennik przejść w rejestrze ma jednego piszącego)
+static void gate_task(void* arg) {
+    int gate_id = *(int*)arg;
+    bool stolen;
+    Skier* skier = gate_take(gate_id, &stolen);
+    if (skier) {
+        pass_gate(gate_id, skier, stolen);
+    }
+
+    // Bramka pracuje, dopóki ona lub jej sąsiedzi mają kolejkę
+    if (gate_has_work(gate_id)) {
+        sched->schedule(0, gate_task, arg);
+    } else {
+        gate_deactivate(gate_id);
+        if (gate_depth(gate_id) > 0 && gate_try_activate(gate_id)) {
+            sched->schedule(0, gate_task, arg);
+        }
+    }
+}
+
+// Zejście z krzesełka na górnej stacji i wybór trasy prowadzącej do kolejnej kolejki;
+// grupa zjeżdża razem trasą wybraną przez prowadzącego
+static void alight(Skier* skier) {
+    __sync_add_and_fetch(&stats.rides, skier->group_size);
+
+    // Wybor trasy i czas przejazdu
+    skier->track = rng_below(&skier->rng, CONFIG_TRACKS);
+    Trail* trail = &trails[skier->lift * CONFIG_TRACKS + skier->track];
+    __sync_add_and_fetch(&trail->descents, skier->group_size);
+
+    // Zapis zjazdu każdej osoby w księdze przejazdów
+    sim_time_t now = sched->now();
+    for (Skier* rider = skier; rider; rider = rider->group_next) {
+        log_event(EV_ALIGHT, rider->skier_id, 0);
+        trace_record(TRACE_ALIGHT, rider->skier_id, rider->lift, 0);
+        trace_record(TRACE_TRAIL, rider->skier_id, rider->lift, skier->track);
+        rider->track = skier->track;
+        rider->lift = trail->to_lift;
+        ledger_add_ride(rider->skier_id, rider->track);
+        usage_add_ride(rider, now);
+        rider->state = SKIER_ON_TRACK;
+        rider->stage_at = now;
+    }
+
+    // Czas zjazdu zależy od tempa narciarza (grupy: prowadzącego) i zatłoczenia trasy
+    float pace = 0.8f + 0.4f * (float)rng_unit(&skier->rng);
+    int start = slope_enter((int)(trail - trails), skier, pace);
+    if (start == 1) {
+        sched->schedule(SLOPE_TICK, slope_tick_task, NULL);
+    } else if (start == -1) {
+        sched->schedule((sim_time_t)trail->time * config.sim_seconds_per_step, descent_end_task, skier);
+    }
+}
+
+// Ruch liny o jedno krzesełko: wysiadanie na górze, wsiadanie grupy na dole
+static void lift_tick_task(void* arg) {
+    LiftShard* shard = arg;
+    Skier* alighting[config.max_people_on_chair];
+    Skier* boarders[config.max_people_on_chair];
+
+    LOCK_MUTEX(&shard->mutex, LOCK_SHARD, (int)(shard - shards));
+    bool is_emptied = !is_station_open && shard->on_platform == 0;
+    bool is_drained = is_emptied && shard->on_chairs == 0;
+    if (!lift_is_running(shard) || is_drained) {
+        shard->tick_scheduled = false;
+        if (is_drained) {
+            lift_transition(shard, 0, LIFT_PLATFORM_EMPTY | LIFT_DRAINED);
+        }
+        pthread_mutex_unlock(&shard->mutex);
+        return;
+    }
+
+    if (is_emptied && !(atomic_load(&shard->state) & LIFT_PLATFORM_EMPTY)) {
+        lift_transition(shard, 0, LIFT_PLATFORM_EMPTY);
+    }
+
+    int alighted = lift_unload(&shard->lift, alighting);
+    shard->on_chairs -= alighted;
+
+    // VIP ma pierwszenstwo, zwykli narciarze nie czekaja dluzej niz prog postarzania
+    sim_time_t now = sched->now();
+    int count = board_select(&shard->boarding, now, boarders, config.max_people_on_chair);
+    lift_board(&shard->lift, boarders, count);
+    shard->on_chairs += count;
+    shard->on_platform -= count;
+    for (int i = 0; i < count; i++) {
+        boarders[i]->state = SKIER_ON_CHAIR;
+        trace_record(TRACE_BOARD, boarders[i]->skier_id, shard->lift_id, boarders[i]->ticket.is_vip);
+        ledger_add_wait(boarders[i]->skier_id, now - boarders[i]->queued_at);
+        hist_record(HIST_TOTAL_WAIT, now - boarders[i]->queued_at);
+        hist_record(boarders[i]->ticket.is_vip ? HIST_CHAIR_WAIT_VIP : HIST_CHAIR_WAIT, now - boarders[i]->stage_at);
+        if (boarders[i]->group_size > 1) {
+            log_event(EV_GROUP_BOARD, boarders[i]->skier_id, boarders[i]->group_size);
+        }
+        if (boarders[i]->ticket.is_vip) {
+            log_event(EV_BOARD_VIP, boarders[i]->skier_id, 0);
+        } else {
+            log_event(EV_BOARD, boarders[i]->skier_id, 0);
+        }
+    }
+
+    // Zwolnione miejsca na peronie, w kolejności oczekiwania
+    while (shard->platform_queue.head && platform_fits(shard, shard->platform_queue.head)) {
+        Skier* waiting = skier_queue_pop(&shard->platform_queue);
+        shard->platform_waiting -= waiting->group_size;
+        enter_platform_locked(shard, waiting);
+    }
+
+    lift_advance(&shard->lift);
+    sched->schedule(CHAIR_INTERVAL, lift_tick_task, shard);
+    pthread_mutex_unlock(&shard->mutex);
+
+    for (int i = 0; i < alighted; i++) {
+        if (!alighting[i]->leader) { // Członkowie grupy schodzą razem z prowadzącym
+            alight(alighting[i]);
+        }
+    }
+}
+
+// Koniec zjazdu: kolejny przejazd albo koniec dnia (grupy: po wygaśnięciu pierwszego z biletów)
+static void descent_end_task(void* arg) {
+    Skier* skier = arg;
+    sim_time_t now = sched->now();
+    bool valid = is_station_open;
+    for (Skier* rider = skier; rider; rider = rider->group_next) {
+        log_event(EV_TRACK, rider->skier_id, rider->track + 1);
+        hist_record(HIST_DESCENT, now - rider->stage_at);
+        trace_record(TRACE_DESCENT_END, rider->skier_id, rider->lift, rider->track);
+        valid = valid && now < rider->ticket.expiry_time * 60;
+    }
+
+    if (valid) {
+        enter_gate(skier);
+    } else {
+        finish_skier(skier);
+    }
+}
+
+// Krok ruchu narciarzy na wszystkich trasach, planowany tylko, gdy ktoś zjeżdża
+static void slope_tick_task(void* arg) {
+    (void)arg;
+    bool active;
+    Skier* finished = slopes_advance(sched->now(), SLOPE_TICK, &active);
+    if (active) {
+        sched->schedule(SLOPE_TICK, slope_tick_task, NULL);
+    }
+    while (finished) {
+        Skier* next = finished->next;
+        finished->next = NULL;
+        descent_end_task(finished);
+        finished = next;
+    }
+}
+
+// Przybycie nowego narciarza razem z jego grupą
+static void admit_skier(void) {
+    Skier* skier = create_skier(next_skier_id++);
+    if (!skier) {
+        return;
+    }
+    form_group(skier);
+    __sync_add_and_fetch(&stats.skiers, skier->group_size);
+    LOCK_MUTEX(&station_mutex, LOCK_STATION, 0);
+    bool admitted = is_station_open && can_ski(skier);
+    if (admitted) {
+        active_skiers += skier->group_size;
+    }
+    pthread_mutex_unlock(&station_mutex);
+
+    if (admitted) {
+        for (Skier* rider = skier; rider; rider = rider->group_next) {
+            ledger_register(rider->skier_id, rider->ticket.ticket_type, rider->ticket.is_vip);
+            usage_add_skier(rider);
+        }
+        enter_gate(skier);
+    } else {
+        trace_group(TRACE_DONE, skier, 0); // Odrzuceni przy kasie: ślad nie kończy się na zakupie biletu
+        free_group(skier);
+    }
+}
+
+// Kolejne przygotowane przybycie (paczka uzupełniana z generatora), -1 po ostatnim przybyciu dnia
+static sim_time_t peek_arrival(void) {
+    if (arrival_next == arrival_count) {
+        arrival_count = arrivals_fill(arrival_times, ARRIVALS_BATCH);
+        arrival_next = 0;
+        if (arrival_count == 0) {
+            return -1;
+        }
+    }
+    return arrival_times[arrival_next];
+}
+
+// Przybycia: wszyscy narciarze, których czas nadszedł, jednym zadaniem, a potem zaplanowanie kolejnego
+static void arrival_task(void* arg) {
+    (void)arg;
+    sim_time_t now = sched->now() - day_start;
+    sim_time_t next;
+    int admitted = 0;
+    while ((next = peek_arrival()) != -1 && next <= now) {
+        if (!is_station_open || station_arrivals_exhausted()) {
+            return;
+        }
+        if (admitted == ARRIVALS_PER_TASK) {
+            sched->schedule(0, arrival_task, NULL); // Reszta zaległych przybyć po zadaniach czekających w kolejce
+            return;
+        }
+        arrival_next++;
+        admit_skier();
+        admitted++;
+    }
+    if (next != -1) {
+        sched->schedule(next - now, arrival_task, NULL);
+    }
+}
+
+// Zamknięcie bramek (wymaga station_mutex); budzi czekających na zamknięcie stacji
+static bool close_station_locked(void) {
+    if (!is_station_open) {
+        return false;
+    }
+    is_station_open = false;
+    sim_time_t now = sched->now();
+    open_seconds += now < DAY_LENGTH ? now : DAY_LENGTH;
+    pthread_cond_broadcast(&station_closed_cond);
+    return true;
+}
+
+// Symulacja czasu
+static void clock_task(void* arg) {
+    (void)arg;
+    simulated_time = sched->now() / 60;
+    if (simulated_time > 0 && simulated_time % 60 == 0) {
+        log_event(EV_HOUR, simulated_time / 60, 0);
+    }
+
+    if (sched->now() >= DAY_LENGTH || !is_station_open) {
+        LOCK_MUTEX(&station_mutex, LOCK_STATION, 0);
+        bool closed = close_station_locked();
+        pthread_mutex_unlock(&station_mutex);
+        if (closed) {
+            log_event(EV_STATION_CLOSING, 0, 0);
+        }
+        return; // Po przerwaniu zegar kończy pracę przy najbliższym kroku
+    }
+    sched->schedule(config.sim_seconds_per_step, clock_task, NULL);
+}
+
+// Funkcja zatrzymująca kolejkę linową
+void stop_lift(int lift_id, int worker_id) {
+
+    LiftShard* shard = &shards[lift_id];
+    LOCK_MUTEX(&shard->mutex, LOCK_SHARD, (int)(shard - shards));
+    if (lift_is_running(shard)) {
+        lift_transition(shard, LIFT_RUNNING, 0);
+        shard->stopped_at = sched->now();
+        shard->stops++;
+        __sync_add_and_fetch(&stats.lift_stops, 1);
+        log_event(EV_LIFT_STOP, lift_id, worker_id);
+        trace_record(TRACE_LIFT_STOP, -1, lift_id, worker_id);
+        ChairLift* lift = &shard->lift;
+        for (int i = 0; i < lift->num_chairs; i++) {
+            for (int j = 0; j < lift->chairs[i].occupied; j++) {
+                log_event(EV_RIDE_STOPPED, lift->chairs[i].riders[j]->skier_id, 0);
+            }
+        }
+    }
+    pthread_mutex_unlock(&shard->mutex);
+}
+
+// Funkcja wznawiając kolejkę linową
+void resume_lift(int lift_id, int worker_id) {
+
+    LiftShard* shard = &shards[lift_id];
+    LOCK_MUTEX(&shard->mutex, LOCK_SHARD, (int)(shard - shards));
+    if (!lift_is_running(shard) && !(atomic_load(&shard->state) & LIFT_DRAINED)) { // Opróżniona kolejka już nie rusza
+        lift_transition(shard, 0, LIFT_RUNNING);
+        hist_record(HIST_LIFT_STOP, sched->now() - shard->stopped_at);
+        log_event(EV_LIFT_RESUME, lift_id, worker_id);
+        trace_record(TRACE_LIFT_RESUME, -1, lift_id, worker_id);
+        if (!shard->tick_scheduled) {
+            shard->tick_scheduled = true;
+            sched->schedule(CHAIR_INTERVAL, lift_tick_task, shard);
+        }
+    }
+    pthread_mutex_unlock(&shard->mutex);
+}
+
+// Ostateczne zatrzymanie kolejki po opróżnieniu peronu albo przy przerwaniu programu
+void lift_halt(int lift_id) {
+    LiftShard* shard = &shards[lift_id];
+    LOCK_MUTEX(&shard->mutex, LOCK_SHARD, (int)(shard - shards));
+    lift_transition(shard, LIFT_RUNNING, 0);
+    pthread_mutex_unlock(&shard->mutex);
+}
+
+unsigned lift_state(int lift_id) {
+    return atomic_load(&shards[lift_id].state);
+}
+
+// Oczekiwanie na zmianę stanu kolejki względem odczytanego wcześniej słowa
+void lift_wait_state(int lift_id, unsigned seen) {
+    while (atomic_load(&shards[lift_id].state) == seen) {
+        WAIT_FUTEX(&shards[lift_id].state, seen, LOCK_LIFT_STATE, lift_id);
+    }
+}
+
+// Oczekiwanie na zmianę stanu kolejki nie dłuższe niż podany czas
+void lift_wait_state_for(int lift_id, unsigned seen, long timeout_ms) {
+    if (atomic_load(&shards[lift_id].state) == seen) {
+        WAIT_FUTEX_FOR(&shards[lift_id].state, seen, timeout_ms, LOCK_LIFT_STATE, lift_id);
+    }
+}
+
+sim_time_t station_now(void) {
+    return sched->now();
+}
+
+// Odczyt stanu kolejki i zapełnienia krzesełek (max_chairs bajtów) do podglądu na żywo
+void station_sample_lift(int lift_id, LiftSample* sample, unsigned char* chairs) {
+    LiftShard* shard = &shards[lift_id];
+    LOCK_MUTEX(&shard->mutex, LOCK_SHARD, (int)(shard - shards));
+    sample->on_platform = shard->on_platform;
+    sample->platform_waiting = shard->platform_waiting;
+    sample->on_chairs = shard->on_chairs;
+    sample->loading_chair = shard->lift.loading_chair;
+    sample->state = atomic_load(&shard->state);
+    sample->stops = shard->stops;
+    sample->carried = shard->lift.carried;
+    for (int i = 0; i < shard->lift.num_chairs; i++) {
+        chairs[i] = (unsigned char)shard->lift.chairs[i].occupied;
+    }
+    pthread_mutex_unlock(&shard->mutex);
+}
+
+// Trasy z górnej stacji kolejki: trasa k prowadzi do dolnej stacji kolejki (lift + k) % num_lifts,
+// więc przy jednej kolejce wszystkie trasy wracają do niej
+static int trails_init(void) {
+    free(trails);
+    trails = calloc((size_t)num_lifts * CONFIG_TRACKS, sizeof(Trail));
+    if (!trails) {
+        return -1;
+    }
+    for (int lift_id = 0; lift_id < num_lifts; lift_id++) {
+        for (int k = 0; k < CONFIG_TRACKS; k++) {
+            Trail* trail = &trails[lift_id * CONFIG_TRACKS + k];
+            trail->from_lift = lift_id;
+            trail->to_lift = (lift_id + k) % num_lifts;
+            trail->time = config.track_times[k];
+        }
+    }
+    return 0;
+}
+
+static void shards_destroy(void) {
+    for (int i = 0; i < num_lifts; i++) {
+        lift_destroy(&shards[i].lift);
+        pthread_mutex_destroy(&shards[i].mutex);
+    }
+    free(shards);
+    shards = NULL;
+    num_lifts = 0;
+}
+
+// Osobny stan dla każdej kolejki
+static int shards_init(void) {
+    shards = aligned_alloc(CACHE_LINE, sizeof(LiftShard) * config.num_lifts);
+    if (!shards) {
+        return -1;
+    }
+    memset(shards, 0, sizeof(LiftShard) * config.num_lifts);
+    for (int i = 0; i < config.num_lifts; i++) {
+        LiftShard* shard = &shards[i];
+        if (lift_init(&shard->lift) == -1) {
+            shards_destroy();
+            return -1;
+        }
+        num_lifts = i + 1;
+        pthread_mutex_init(&shard->mutex, NULL);
+        board_init(&shard->boarding, config.max_people_on_chair);
+        atomic_init(&shard->state, LIFT_RUNNING);
+        shard->lift_id = i;
+    }
+    return 0;
+}
+
+// Inicjalizacja stacji
+int station_init(const Scheduler* scheduler) {
+    sched = scheduler;
+    log_set_clock(scheduler->now);
+    trace_set_clock(scheduler->now);
+    next_skier_id = 0;
+    open_seconds = 0;
+    arrivals_init();
+    if (shards_init() == -1 || trails_init() == -1 || slopes_init(trails, num_lifts * CONFIG_TRACKS) == -1) {
+        return -1;
+    }
+    int total_gates = config.num_lifts * config.num_gates;
+    free(gate_ids);
+    gate_ids = malloc(sizeof(int) * total_gates);
+    if (!gate_ids) {
+        return -1;
+    }
+    for (int i = 0; i < total_gates; i++) {
+        gate_ids[i] = i;
+    }
+    if (registry_init(total_gates) == -1) {
+        return -1;
+    }
+    return gates_init(GATE_SHORTEST_QUEUE);
+}
+
+// Częstość przybyć i limit narciarzy (0 przywraca wartości domyślne)
+void station_set_arrivals(double skiers_per_hour, int limit) {
+    arrivals_set_rate(skiers_per_hour > 0 ? skiers_per_hour : -1);
+    skier_limit = limit;
+}
+
+// Czy utworzono już wszystkich narciarzy dopuszczonych limitem
+bool station_arrivals_exhausted(void) {
+    return skier_limit > 0 && next_skier_id >= skier_limit;
+}
+
+// Otwarcie stacji na kolejny dzień
+void station_open_day(void) {
+    simulated_time = 0;
+    is_station_open = true;
+    active_skiers = 0;
+    memset(&stats, 0, sizeof(stats));
+    trace_begin_day();
+
+    arrivals_begin_day();
+    arrival_next = arrival_count = 0;
+    day_start = sched->now();
+    for (int i = 0; i < num_lifts; i++) {
+        LiftShard* shard = &shards[i];
+        lift_transition(shard, LIFT_DRAINED | LIFT_PLATFORM_EMPTY, LIFT_RUNNING);
+        shard->on_platform = 0;
+        shard->on_chairs = 0;
+        shard->platform_waiting = 0;
+        shard->tick_scheduled = true;
+        sched->schedule(CHAIR_INTERVAL, lift_tick_task, shard);
+    }
+    // Przybycia dopiero po wyzerowaniu kolejek: w puli wątków pierwsze zadanie rusza od razu
+    sched->schedule(0, arrival_task, NULL);
+    sched->schedule(config.sim_seconds_per_step, clock_task, NULL);
+}
+
+// Zamknięcie stacji przed końcem dnia (przerwanie programu); narciarze kończą dzień jak po zamknięciu
+void station_close(void) {
+    LOCK_MUTEX(&station_mutex, LOCK_STATION, 0);
+    bool closed = close_station_locked();
+    pthread_mutex_unlock(&station_mutex);
+    if (closed) {
+        log_event(EV_STATION_CLOSING, 0, 0);
+    }
+}
+
+// Oczekiwanie na zamknięcie bramek
+void station_wait_closing(void) {
+    LOCK_MUTEX(&station_mutex, LOCK_STATION, 0);
+    while (is_station_open) {
+        WAIT_COND(&station_closed_cond, &station_mutex, LOCK_STATION_CLOSED, 0);
+    }
+    pthread_mutex_unlock(&station_mutex);
+}
+
+// Oczekiwanie na zamknięcie stacji i koniec dnia wszystkich narciarzy
+void station_wait_closed(void) {
+    LOCK_MUTEX(&station_mutex, LOCK_STATION, 0);
+    while (is_station_open || active_skiers > 0) {
+        WAIT_COND(&station_closed_cond, &station_mutex, LOCK_STATION_CLOSED, 0);
+    }
+    pthread_mutex_unlock(&station_mutex);
+}
+
+int station_skier_count(void) {
+    return next_skier_id;
+}
+
+// Narciarze na peronach wszystkich kolejek
+int station_platform_count(void) {
+    int count = 0;
+    for (int i = 0; i < num_lifts; i++) {
+        LOCK_MUTEX(&shards[i].mutex, LOCK_SHARD, i);
+        count += shards[i].on_platform;
+        pthread_mutex_unlock(&shards[i].mutex);
+    }
+    return count;
+}
+
+// Narciarze na krzesełkach wszystkich kolejek
+int station_chair_count(void) {
+    int count = 0;
+    for (int i = 0; i < num_lifts; i++) {
+        LOCK_MUTEX(&shards[i].mutex, LOCK_SHARD, i);
+        count += shards[i].on_chairs;
+        pthread_mutex_unlock(&shards[i].mutex);
+    }
+    return count;
+}
+
+StationStats station_day_stats(void) {
+    return stats;
+}
+
+StationTotals station_totals(void) {
+    StationTotals totals = { 0 };
+    for (int i = 0; i < num_lifts; i++) {
+        LOCK_MUTEX(&shards[i].mutex, LOCK_SHARD, i);
+        totals.seats += shards[i].lift.carried;
+        totals.seats_offered += shards[i].boarding.seats_offered;
+        totals.seats_lost += shards[i].boarding.seats_lost;
+        totals.groups += shards[i].boarding.groups;
+        totals.lift_hours += shards[i].lift.running_time / 3600.0;
+        pthread_mutex_unlock(&shards[i].mutex);
+    }
+    totals.skiers = next_skier_id;
+    totals.gate_passes = gates_total_passes();
+    totals.open_hours = open_seconds / 3600.0;
+    return totals;
+}
+
+// Zwolnienie struktur stacji o rozmiarach z konfiguracji
+void station_destroy(void) {
+    skier_arena_destroy();
+    gates_destroy();
+    registry_destroy();
+    shards_destroy();
+    slopes_destroy();
+    free(trails);
+    trails = NULL;
+    free(gate_ids);
+    gate_ids = NULL;
+    arrivals_destroy();
+}
+
+// Raport zapełnienia krzesełek, przepustowości kolejek, tras, bramek i kontroli biletów
+void station_print_report(void) {
+    for (int i = 0; i < num_lifts; i++) {
+        LOCK_MUTEX(&shards[i].mutex, LOCK_SHARD, i);
+        lift_print_report(&shards[i].lift, i);
+        board_print_report(&shards[i].boarding, shards[i].lift.running_time / 3600.0);
+        pthread_mutex_unlock(&shards[i].mutex);
+    }
+    slopes_print_report(trails);
+    gates_print_report(open_seconds / 3600.0);
+    registry_print_report();
+    hist_print_report();
+}
@@ -0,0 +1,133 @@
+#ifndef STATION_H
+#define STATION_H
+
+#include <stdbool.h>
+#include <pthread.h>
+#include "ticket.h"
+#include "des.h"
+#include "config.h"
+#include "rng.h"
+
+// Etap dnia narciarza
+typedef enum {
+    SKIER_AT_GATE,          // W kolejce do bramki
+    SKIER_WAITING_FOR_PLATFORM, // Czeka na miejsce na peronie
+    SKIER_ON_PLATFORM,      // Na peronie, czeka na krzesełko
+    SKIER_ON_CHAIR,         // Jedzie krzesełkiem
+    SKIER_ON_TRACK,         // Zjeżdża trasą
+    SKIER_DONE              // Zakończył dzień
+} SkierState;
+
+// Struktura narciarza
+typedef struct Skier {
+    int skier_id;       // ID narciarza
+    int age;            // Wiek
+    bool is_vip;        // Czy VIP
+    bool is_guardian;   // Czy opiekun
+    Ticket ticket;      // Bilet (w rekordzie narciarza, bez osobnej alokacji)
+    bool is_child;      // Czy narciarz jest dzieckiem
+    SkierState state;   // Bieżący etap (zadanie narciarza nie zajmuje wątku)
+    int track;          // Wybrana trasa (0-2 z górnej stacji kolejki)
+    int lift;           // Kolejka, do której narciarz zmierza lub którą jedzie
+    sim_time_t queued_at; // Chwila ustawienia się w kolejce do bramki
+    sim_time_t stage_at;  // Początek oczekiwania na bieżącym etapie
+    Rng rng;            // Własny strumień losowy narciarza
+    int group_size;     // Osoby w grupie prowadzonej przez narciarza (1: bez grupy)
+    struct Skier* group_next; // Kolejny członek grupy (lista od prowadzącego)
+    struct Skier* leader;     // Prowadzący grupę (NULL: narciarz prowadzi sam siebie)
+    struct Skier* next; // Następny w kolejce oczekujących
+} Skier;
+
+#define GROUP_MAX_CHILDREN 2 // Dzieci pod opieką jednego opiekuna
+
+// Trasa łącząca górną stację jednej kolejki z dolną stacją kolejnej
+typedef struct {
+    int from_lift;
+    int to_lift;
+    int time;           // Czas przejazdu (w sekundach)
+    long descents;      // Liczba zjazdów
+} Trail;
+
+// Planista zdarzeń: zegar wirtualny (des.c) albo pula wątków w czasie rzeczywistym (pool.c)
+typedef struct {
+    sim_time_t (*now)(void);
+    void (*schedule)(sim_time_t delay, DesHandler handler, void* arg);
+} Scheduler;
+
+// Statystyki bieżącego dnia
+typedef struct {
+    int skiers;      // Liczba przybyłych narciarzy
+    int rides;       // Liczba zjazdów
+    int lift_stops;  // Liczba zatrzymań kolejki
+} StationStats;
+
+// Wyniki wszystkich dni od inicjalizacji stacji
+typedef struct {
+    long skiers;        // Liczba utworzonych narciarzy
+    long gate_passes;   // Przejścia przez bramki
+    long seats;         // Zajęte miejsca na krzesełkach
+    long seats_offered; // Wszystkie miejsca krzesełek w punktach załadunku
+    long seats_lost;    // Miejsca puste mimo oczekujących na peronie (grupy się nie mieściły)
+    long groups;        // Grupy, które wsiadły razem na jedno krzesełko
+    double open_hours;  // Łączny czas otwarcia stacji
+    double lift_hours;  // Łączny czas pracy kolejki
+} StationTotals;
+
+// Stan jednej kolejki w chwili odczytu (podgląd na żywo)
+typedef struct {
+    int on_platform;      // Narciarze na peronie
+    int platform_waiting; // Narciarze czekający na miejsce na peronie
+    int on_chairs;        // Narciarze na krzesełkach
+    int loading_chair;    // Krzesełko w punkcie załadunku
+    unsigned state;       // Flagi LIFT_* i epoka
+    long stops;           // Zatrzymania przez pracownika kolejki
+    long carried;         // Przewiezieni narciarze
+} LiftSample;
+
+// Stan stacji
+extern volatile int simulated_time;
+extern volatile bool is_station_open;
+extern pthread_mutex_t station_mutex;
+
+// Stan kolejki w jednym słowie atomowym: flagi i numer epoki zwiększany przy każdej zmianie,
+// więc oczekujący na futeksie budzi się tylko wtedy, gdy stan rzeczywiście się zmienił
+#define LIFT_RUNNING    0x1u  // Lina jedzie
+#define LIFT_DRAINED    0x2u  // Po zamknięciu stacji peron i krzesełka są puste
+#define LIFT_PLATFORM_EMPTY 0x4u  // Po zamknięciu stacji peron jest pusty (krzesełka mogą jeszcze jechać)
+#define LIFT_EPOCH_STEP 0x8u
+
+// Para pracowników obsługujących kolejkę
+#define LIFT_WORKER_ID(lift) (2 * (lift) + 1)
+#define LIFT_RESPONDER_ID(lift) (2 * (lift) + 2)
+
+// Funkcja obslugi dzieci i opiekunów (sprawdza całą grupę prowadzącego)
+bool can_ski(Skier* skier);
+
+// Utworzenie narciarza wraz z zakupem biletu
+Skier* create_skier(int skier_id);
+
+// Funkcje stacji
+int station_init(const Scheduler* scheduler);
+void station_set_arrivals(double skiers_per_hour, int skier_limit);
+bool station_arrivals_exhausted(void);
+void station_open_day(void);
+void station_close(void);
+void station_wait_closing(void);
+void station_wait_closed(void);
+int station_skier_count(void);
+int station_platform_count(void);
+int station_chair_count(void);
+StationStats station_day_stats(void);
+StationTotals station_totals(void);
+void station_print_report(void);
+void station_destroy(void);
+void stop_lift(int lift_id, int worker_id);
+void resume_lift(int lift_id, int worker_id);
+void lift_halt(int lift_id);
+unsigned lift_state(int lift_id);
+void lift_wait_state(int lift_id, unsigned seen);
+void lift_wait_state_for(int lift_id, unsigned seen, long timeout_ms);
+sim_time_t station_now(void);
+void station_sample_lift(int lift_id, LiftSample* sample, unsigned char* chairs);
+
+#endif
@@ -0,0 +1,556 @@
+#include <errno.h>
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/wait.h>
+#include <time.h>
+#include <unistd.h>
+#include "station.h"
+#include "des.h"
+#include "hist.h"
+#include "ledger.h"
+#include "arrivals.h"
+#include "config.h"
+#include "rng.h"
+
+// Przegląd parametrów metodą Monte Carlo: każdy przebieg (punkt siatki x powtórzenie) to osobny proces
+// potomny z symulacją zdarzeń dyskretnych, więc stan modułów stacji jest odizolowany bez żadnych zmian
+// w symulacji. Wyniki wracają łączem do procesu głównego, który podaje średnie z 95% przedziałami ufności.
+
+#define SWEEP_MAX_PARAMS 8
+#define SWEEP_MAX_VALUES 64
+#define SWEEP_MAX_POINTS 4096
+#define SWEEP_KEY_MAX 64
+#define SWEEP_DRAW_ATTEMPTS 64    // Prób losowania na jeden punkt (odrzucane powtórzenia)
+#define SWEEP_DEFAULT_REPLICAS 5
+#define SWEEP_DEFAULT_SAMPLES 16
+#define SWEEP_DEFAULT_DAYS 3
+#define SWEEP_DEFAULT_RATE 600.0  // Narciarzy na godzinę
+#define SWEEP_DEFAULT_SEED 1
+
+// Mierzone wielkości jednego przebiegu
+enum {
+    METRIC_GATE_PER_HOUR,
+    METRIC_SEATS_PER_HOUR,
+    METRIC_WAIT_P50,
+    METRIC_WAIT_P95,
+    METRIC_CHAIR_WAIT_P95,
+    METRIC_SEATS_LOST,
+    SWEEP_METRICS
+};
+
+static const char* metric_keys[SWEEP_METRICS] = {
+    "gate_skiers_per_hour", "lift_seats_per_hour", "wait_p50_s", "wait_p95_s", "chair_wait_p95_s", "seats_lost_pct"
+};
+static const char* metric_names[SWEEP_METRICS] = {
+    "Przepustowosc bramek (narciarze/h)", "Przepustowosc kolejek (miejsca/h)", "Oczekiwanie p50 (s)",
+    "Oczekiwanie p95 (s)", "Oczekiwanie na krzeselko p95 (s)", "Utracone miejsca (%)"
+};
+
+// Parametr przeglądu: lista wartości (--grid) albo przedział losowania (--range)
+typedef struct {
+    const char* key;
+    int values[SWEEP_MAX_VALUES];
+    int count;      // 0: przedział [min, max]
+    int min;
+    int max;
+} SweepParam;
+
+// Wynik przebiegu przesyłany łączem (mniejszy niż PIPE_BUF, więc zapis jest niepodzielny)
+typedef struct {
+    int point;
+    int replica;
+    long skiers;
+    double metrics[SWEEP_METRICS];
+} SweepResult;
+
+// Proces potomny w trakcie przebiegu
+typedef struct {
+    pid_t pid;
+    int fd;
+    int job;
+} SweepWorker;
+
+// Punkt przeglądu z zebranymi wynikami
+typedef struct {
+    int values[SWEEP_MAX_PARAMS];
+    bool valid;
+    int done;       // Udane powtórzenia
+    double sum[SWEEP_METRICS];
+    double sum_sq[SWEEP_METRICS];
+    long skiers;
+} SweepPoint;
+
+static SweepParam params[SWEEP_MAX_PARAMS];
+static int param_count;
+static SweepPoint points[SWEEP_MAX_POINTS];
+static int point_count;
+
+static void usage(const char* program) {
+    fprintf(stderr, "Uzycie: %s [--grid klucz=w1,w2,...]... [--range klucz=min:max]... [--samples N]\n"
+                    "       [--replicas N] [--jobs N] [--days N] [--rate narciarzy_na_h] [--skiers N] [--seed N]\n"
+                    "       [--format text|csv|json] [--arrivals proces] [--arrivals-file plik.csv]\n"
+                    "       [--arrival-profile wagi] [--config plik] [--set klucz=wartosc]...\n", program);
+}
+
+// Parametr o podanej nazwie (dopisywany przy pierwszym użyciu); klucz sprawdza config_set
+static SweepParam* add_param(const char* assignment, char* buffer, size_t size, char** value) {
+    snprintf(buffer, size, "%s", assignment);
+    char* equals = strchr(buffer, '=');
+    if (!equals || equals[1] == '\0') {
+        fprintf(stderr, "Blad: Oczekiwano klucz=wartosci, otrzymano: %s.\n", assignment);
+        return NULL;
+    }
+    *equals = '\0';
+    Config scratch = config;
+    if (config_set(&scratch, buffer, "0") == -1) {
+        return NULL;
+    }
+    for (int p = 0; p < param_count; p++) {
+        if (strcmp(params[p].key, buffer) == 0) {
+            fprintf(stderr, "Blad: Parametr %s podano wiecej niz raz.\n", buffer);
+            return NULL;
+        }
+    }
+    if (param_count == SWEEP_MAX_PARAMS) {
+        fprintf(stderr, "Blad: Przeglad obejmuje najwyzej %d parametrow.\n", SWEEP_MAX_PARAMS);
+        return NULL;
+    }
+    SweepParam* param = &params[param_count++];
+    memset(param, 0, sizeof(*param));
+    param->key = buffer;
+    *value = equals + 1;
+    return param;
+}
+
+// --grid klucz=w1,w2,...
+static int parse_grid(const char* assignment, char* buffer, size_t size) {
+    char* list;
+    SweepParam* param = add_param(assignment, buffer, size, &list);
+    if (!param) {
+        return -1;
+    }
+    char* end = list;
+    while (param->count < SWEEP_MAX_VALUES) {
+        char* text = end;
+        long value = strtol(text, &end, 10);
+        if (end == text) {
+            break;
+        }
+        param->values[param->count++] = (int)value;
+        if (*end != ',') {
+            break;
+        }
+        end++;
+    }
+    if (*end != '\0' || param->count == 0) {
+        fprintf(stderr, "Blad: Nieprawidlowa lista wartosci: %s.\n", assignment);
+        return -1;
+    }
+    return 0;
+}
+
+// --range klucz=min:max
+static int parse_range(const char* assignment, char* buffer, size_t size) {
+    char* range;
+    SweepParam* param = add_param(assignment, buffer, size, &range);
+    if (!param) {
+        return -1;
+    }
+    char tail;
+    if (sscanf(range, "%d:%d%c", &param->min, &param->max, &tail) != 2 || param->min > param->max) {
+        fprintf(stderr, "Blad: Nieprawidlowy przedzial: %s.\n", assignment);
+        return -1;
+    }
+    return 0;
+}
+
+// Konfiguracja punktu: konfiguracja bazowa z nadpisanymi parametrami przeglądu
+static int point_config(const SweepPoint* point, Config* out) {
+    *out = config;
+    for (int p = 0; p < param_count; p++) {
+        char value[16];
+        snprintf(value, sizeof(value), "%d", point->values[p]);
+        if (config_set(out, params[p].key, value) == -1) {
+            return -1;
+        }
+    }
+    return 0;
+}
+
+static void print_point(FILE* out, const SweepPoint* point) {
+    for (int p = 0; p < param_count; p++) {
+        fprintf(out, "%s%s=%d", p > 0 ? " " : "", params[p].key, point->values[p]);
+    }
+}
+
+// Liczba wartości parametru: elementy listy albo liczby całkowite przedziału
+static long param_size(const SweepParam* param) {
+    return param->count > 0 ? param->count : (long)param->max - param->min + 1;
+}
+
+static int param_value(const SweepParam* param, long index) {
+    return param->count > 0 ? param->values[index] : param->min + (int)index;
+}
+
+// Wszystkie kombinacje wartości parametrów (ostatni parametr zmienia się najszybciej)
+static void enumerate_points(int total) {
+    for (int i = 0; i < total; i++) {
+        long rest = i;
+        for (int p = param_count - 1; p >= 0; p--) {
+            points[i].values[p] = param_value(&params[p], rest % param_size(&params[p]));
+            rest /= param_size(&params[p]);
+        }
+    }
+    point_count = total;
+}
+
+static bool point_drawn(const SweepPoint* point) {
+    for (int i = 0; i < point_count; i++) {
+        if (memcmp(points[i].values, point->values, sizeof(int) * param_count) == 0) {
+            return true;
+        }
+    }
+    return false;
+}
+
+// Punkty przeglądu: iloczyn kartezjański siatki albo samples różnych punktów losowych
+static int build_points(int samples, uint64_t seed) {
+    if (samples > 0) {
+        if (samples > SWEEP_MAX_POINTS) {
+            samples = SWEEP_MAX_POINTS;
+        }
+        double distinct = 1;
+        for (int p = 0; p < param_count; p++) {
+            distinct *= param_size(&params[p]);
+        }
+        if (distinct <= samples) {
+            // Losowanie bez powtórzeń wyczerpałoby wszystkie kombinacje
+            fprintf(stderr, "Uwaga: Tylko %.0f roznych punktow, przeglad obejmuje wszystkie.\n", distinct);
+            enumerate_points((int)distinct);
+        } else {
+            // Powtórzony punkt jest odrzucany, a liczba prób ograniczona
+            Rng rng;
+            rng_set_seed(seed);
+            rng_init(&rng, RNG_STREAM_SWEEP);
+            point_count = 0;
+            for (long attempts = 0; point_count < samples && attempts < (long)samples * SWEEP_DRAW_ATTEMPTS; attempts++) {
+                SweepPoint* point = &points[point_count];
+                for (int p = 0; p < param_count; p++) {
+                    point->values[p] = param_value(&params[p], rng_below(&rng, (int)param_size(&params[p])));
+                }
+                if (!point_drawn(point)) {
+                    point_count++;
+                }
+            }
+            if (point_count < samples) {
+                fprintf(stderr, "Uwaga: Wylosowano tylko %d roznych punktow z %d.\n", point_count, samples);
+            }
+        }
+    } else {
+        long total = 1;
+        for (int p = 0; p < param_count; p++) {
+            if (params[p].count == 0) {
+                fprintf(stderr, "Blad: Parametr %s z przedzialem wymaga losowania punktow (--samples).\n",
+                        params[p].key);
+                return -1;
+            }
+            total *= params[p].count;
+            if (total > SWEEP_MAX_POINTS) {
+                fprintf(stderr, "Blad: Siatka ma wiecej niz %d punktow.\n", SWEEP_MAX_POINTS);
+                return -1;
+            }
+        }
+        enumerate_points((int)total);
+    }
+
+    // Punkty z nieprawidłową konfiguracją są pomijane z komunikatem config_validate
+    int valid = 0;
+    for (int i = 0; i < point_count; i++) {
+        Config cfg;
+        points[i].valid = point_config(&points[i], &cfg) == 0 && config_validate(&cfg) == 0;
+        if (points[i].valid) {
+            valid++;
+        } else {
+            fprintf(stderr, "Uwaga: Pominieto punkt ");
+            print_point(stderr, &points[i]);
+            fprintf(stderr, ".\n");
+        }
+    }
+    if (valid == 0) {
+        fprintf(stderr, "Blad: Zaden punkt przegladu nie ma prawidlowej konfiguracji.\n");
+        return -1;
+    }
+    return 0;
+}
+
+// Przebieg w procesie potomnym: własna księga (usuwana od razu), sezon DES i wynik zapisany do łącza
+static void run_replica(int point, int replica, int days, double rate, int skiers, uint64_t seed, int fd) {
+    if (point_config(&points[point], &config) == -1) {
+        _exit(EXIT_FAILURE);
+    }
+    char ledger_path[64];
+    snprintf(ledger_path, sizeof(ledger_path), "/tmp/ski_sweep.%d.ledger", (int)getpid());
+    if (ledger_open(ledger_path) == -1) {
+        fprintf(stderr, "Blad: Nie udalo sie utworzyc ksiegi przejazdow %s.\n", ledger_path);
+        _exit(EXIT_FAILURE);
+    }
+    unlink(ledger_path);
+    rng_set_seed(seed + replica); // To samo ziarno powtórzenia w każdym punkcie: wspólne liczby losowe
+    station_set_arrivals(rate, skiers);
+    des_run_season(days, false);
+
+    StationTotals totals = station_totals();
+    static Histogram wait, chair_wait;
+    hist_snapshot(HIST_TOTAL_WAIT, &wait);
+    hist_snapshot(HIST_CHAIR_WAIT, &chair_wait);
+    SweepResult result = { .point = point, .replica = replica, .skiers = totals.skiers };
+    result.metrics[METRIC_GATE_PER_HOUR] = totals.open_hours > 0 ? totals.gate_passes / totals.open_hours : 0.0;
+    result.metrics[METRIC_SEATS_PER_HOUR] = totals.lift_hours > 0 ? totals.seats / totals.lift_hours : 0.0;
+    result.metrics[METRIC_WAIT_P50] = hist_percentile(&wait, 50);
+    result.metrics[METRIC_WAIT_P95] = hist_percentile(&wait, 95);
+    result.metrics[METRIC_CHAIR_WAIT_P95] = hist_percentile(&chair_wait, 95);
+    result.metrics[METRIC_SEATS_LOST] =
+        totals.seats_offered > 0 ? 100.0 * totals.seats_lost / totals.seats_offered : 0.0;
+    _exit(write(fd, &result, sizeof(result)) == (ssize_t)sizeof(result) ? EXIT_SUCCESS : EXIT_FAILURE);
+}
+
+// Kwantyl 0.975 rozkładu t-Studenta (powyżej 30 stopni swobody przybliżony rozkładem normalnym)
+static double t_quantile(int df) {
+    static const double table[30] = {
+        12.706, 4.303, 3.182, 2.776, 2.571, 2.447, 2.365, 2.306, 2.262, 2.228, 2.201, 2.179, 2.160, 2.145, 2.131,
+        2.120, 2.110, 2.101, 2.093, 2.086, 2.080, 2.074, 2.069, 2.064, 2.060, 2.056, 2.052, 2.048, 2.045, 2.042
+    };
+    return df <= 30 ? table[df - 1] : 1.960;
+}
+
+// Średnia i połowa szerokości 95% przedziału ufności (0 przy jednym powtórzeniu)
+static void interval(const SweepPoint* point, int metric, double* mean, double* half) {
+    int n = point->done;
+    *mean = point->sum[metric] / n;
+    *half = 0.0;
+    if (n > 1) {
+        double variance = (point->sum_sq[metric] - n * *mean * *mean) / (n - 1);
+        *half = t_quantile(n - 1) * sqrt(variance > 0 ? variance : 0.0) / sqrt(n);
+    }
+}
+
+static void print_results(const char* format, int replicas) {
+    if (strcmp(format, "csv") == 0) {
+        for (int p = 0; p < param_count; p++) {
+            printf("%s,", params[p].key);
+        }
+        printf("replicas,skiers");
+        for (int m = 0; m < SWEEP_METRICS; m++) {
+            printf(",%s,%s_ci95", metric_keys[m], metric_keys[m]);
+        }
+        printf("\n");
+    }
+    for (int i = 0; i < point_count; i++) {
+        const SweepPoint* point = &points[i];
+        if (!point->valid || point->done == 0) {
+            continue;
+        }
+        long skiers = point->skiers / point->done;
+        if (strcmp(format, "csv") == 0) {
+            for (int p = 0; p < param_count; p++) {
+                printf("%d,", point->values[p]);
+            }
+            printf("%d,%ld", point->done, skiers);
+            for (int m = 0; m < SWEEP_METRICS; m++) {
+                double mean, half;
+                interval(point, m, &mean, &half);
+                printf(",%.2f,%.2f", mean, half);
+            }
+            printf("\n");
+        } else if (strcmp(format, "json") == 0) {
+            printf("{\"point\":{");
+            for (int p = 0; p < param_count; p++) {
+                printf("%s\"%s\":%d", p > 0 ? "," : "", params[p].key, point->values[p]);
+            }
+            printf("},\"replicas\":%d,\"skiers\":%ld", point->done, skiers);
+            for (int m = 0; m < SWEEP_METRICS; m++) {
+                double mean, half;
+                interval(point, m, &mean, &half);
+                printf(",\"%s\":%.2f,\"%s_ci95\":%.2f", metric_keys[m], mean, metric_keys[m], half);
+            }
+            printf("}\n");
+        } else {
+            printf("\nPunkt #%d: ", i);
+            print_point(stdout, point);
+            printf(" (%d/%d powtorzen, srednio %ld narciarzy)\n", point->done, replicas, skiers);
+            for (int m = 0; m < SWEEP_METRICS; m++) {
+                double mean, half;
+                interval(point, m, &mean, &half);
+                printf("  %-34s %10.1f +- %.1f\n", metric_names[m], mean, half);
+            }
+        }
+    }
+}
+
+static double wall_seconds(void) {
+    struct timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return now.tv_sec + now.tv_nsec / 1e9;
+}
+
+int main(int argc, char* argv[]) {
+
+    if (config_parse_args(&config, argc, argv) == -1 || arrivals_parse_args(argc, argv) == -1) {
+        exit(EXIT_FAILURE);
+    }
+
+    static char keys[SWEEP_MAX_PARAMS][SWEEP_KEY_MAX];
+    int replicas = SWEEP_DEFAULT_REPLICAS;
+    int samples = 0;
+    long jobs = sysconf(_SC_NPROCESSORS_ONLN);
+    int days = SWEEP_DEFAULT_DAYS;
+    double rate = SWEEP_DEFAULT_RATE;
+    int skiers = 0;
+    uint64_t seed = SWEEP_DEFAULT_SEED;
+    const char* format = "text";
+    bool has_range = false;
+    for (int i = 1; i < argc; i++) {
+        if ((strcmp(argv[i], "--grid") == 0 || strcmp(argv[i], "--range") == 0) && i + 1 < argc) {
+            bool grid = strcmp(argv[i], "--grid") == 0;
+            char* buffer = keys[param_count < SWEEP_MAX_PARAMS ? param_count : 0];
+            int rc = grid ? parse_grid(argv[i + 1], buffer, SWEEP_KEY_MAX)
+                          : parse_range(argv[i + 1], buffer, SWEEP_KEY_MAX);
+            if (rc == -1) {
+                exit(EXIT_FAILURE);
+            }
+            has_range |= !grid;
+            i++;
+        } else if (strcmp(argv[i], "--samples") == 0 && i + 1 < argc) {
+            samples = atoi(argv[++i]);
+        } else if (strcmp(argv[i], "--replicas") == 0 && i + 1 < argc) {
+            replicas = atoi(argv[++i]);
+        } else if (strcmp(argv[i], "--jobs") == 0 && i + 1 < argc) {
+            jobs = atol(argv[++i]);
+        } else if (strcmp(argv[i], "--days") == 0 && i + 1 < argc) {
+            days = atoi(argv[++i]);
+        } else if (strcmp(argv[i], "--rate") == 0 && i + 1 < argc) {
+            rate = atof(argv[++i]);
+        } else if (strcmp(argv[i], "--skiers") == 0 && i + 1 < argc) {
+            skiers = atoi(argv[++i]);
+        } else if (strcmp(argv[i], "--seed") == 0 && i + 1 < argc) {
+            seed = strtoull(argv[++i], NULL, 10);
+        } else if (strcmp(argv[i], "--format") == 0 && i + 1 < argc) {
+            format = argv[++i];
+        } else if ((config_is_option(argv[i]) || arrivals_is_option(argv[i])) && i + 1 < argc) {
+            i++; // Obsłużone przez config_parse_args i arrivals_parse_args
+        } else {
+            usage(argv[0]);
+            exit(EXIT_FAILURE);
+        }
+    }
+    if (has_range && samples == 0) {
+        samples = SWEEP_DEFAULT_SAMPLES;
+    }
+    if (replicas <= 0 || jobs <= 0 || days <= 0 || rate <= 0 || skiers < 0 || samples < 0) {
+        fprintf(stderr, "Blad: Liczba powtorzen, procesow, dni i czestosc przybyc musza byc dodatnie.\n");
+        exit(EXIT_FAILURE);
+    }
+    if (strcmp(format, "text") != 0 && strcmp(format, "csv") != 0 && strcmp(format, "json") != 0) {
+        fprintf(stderr, "Blad: Nieznany format wynikow: %s.\n", format);
+        exit(EXIT_FAILURE);
+    }
+    if (build_points(samples, seed) == -1) {
+        exit(EXIT_FAILURE);
+    }
+
+    // Kolejne przebiegi (punkt x powtórzenie) w co najwyżej jobs równoległych procesach potomnych
+    int total = point_count * replicas;
+    SweepWorker* workers = calloc(jobs, sizeof(SweepWorker));
+    if (!workers) {
+        fprintf(stderr, "Blad: Brak pamieci na procesy przegladu.\n");
+        exit(EXIT_FAILURE);
+    }
+    if (strcmp(format, "text") == 0) {
+        printf("Przeglad: %d punktow x %d powtorzen, %d dni po %.0f narciarzy/h (%s), %ld procesow, ziarno %llu.\n",
+               point_count, replicas, days, rate, arrivals_process_name(), jobs, (unsigned long long)seed);
+    }
+    fflush(stdout);
+    double wall_start = wall_seconds();
+    int next = 0;
+    int running = 0;
+    int completed = 0;
+    int failed = 0;
+    while (next < total || running > 0) {
+        while (running < jobs && next < total) {
+            int job = next++;
+            if (!points[job / replicas].valid) {
+                continue;
+            }
+            int pipefd[2];
+            if (pipe(pipefd) == -1) {
+                perror("Blad: pipe");
+                exit(EXIT_FAILURE);
+            }
+            pid_t pid = fork();
+            if (pid == -1) {
+                perror("Blad: fork");
+                exit(EXIT_FAILURE);
+            }
+            if (pid == 0) {
+                close(pipefd[0]);
+                run_replica(job / replicas, job % replicas, days, rate, skiers, seed, pipefd[1]);
+            }
+            close(pipefd[1]);
+            int slot = 0;
+            while (workers[slot].pid != 0) {
+                slot++;
+            }
+            workers[slot] = (SweepWorker){ pid, pipefd[0], job };
+            running++;
+        }
+        if (running == 0) {
+            break;
+        }
+
+        int status;
+        pid_t pid = waitpid(-1, &status, 0);
+        if (pid == -1) {
+            if (errno == EINTR) {
+                continue;
+            }
+            perror("Blad: waitpid");
+            exit(EXIT_FAILURE);
+        }
+        int slot = 0;
+        while (slot < jobs && workers[slot].pid != pid) {
+            slot++;
+        }
+        if (slot == jobs) {
+            continue;
+        }
+        SweepResult result;
+        int job = workers[slot].job;
+        if (WIFEXITED(status) && WEXITSTATUS(status) == 0 &&
+            read(workers[slot].fd, &result, sizeof(result)) == (ssize_t)sizeof(result)) {
+            SweepPoint* point = &points[result.point];
+            completed++;
+            point->done++;
+            point->skiers += result.skiers;
+            for (int m = 0; m < SWEEP_METRICS; m++) {
+                point->sum[m] += result.metrics[m];
+                point->sum_sq[m] += result.metrics[m] * result.metrics[m];
+            }
+        } else {
+            failed++;
+            fprintf(stderr, "Uwaga: Przebieg %d punktu #%d zakonczyl sie bledem.\n", job % replicas, job / replicas);
+        }
+        close(workers[slot].fd);
+        workers[slot].pid = 0;
+        running--;
+    }
+    double wall_used = wall_seconds() - wall_start;
+    free(workers);
+
+    print_results(format, replicas);
+    if (strcmp(format, "text") == 0) {
+        printf("\nPrzebiegi: %d udanych, %d z bledem, %.2f s.\n", completed, failed, wall_used);
+    }
+    return failed > 0 ? EXIT_FAILURE : EXIT_SUCCESS;
+}
@@ -1,30 +1,28 @@
 #include "ticket.h"
-#include <stdlib.h>
-#include <stdio.h>
-
-// Zakup biletu
-Ticket* purchase_ticket(int skier_id, int age) {
-    Ticket* ticket = malloc(sizeof(Ticket));
-    if (!ticket) { // Sprawdzenie alokacji
-        fprintf(stderr, "Blad: Nie udalo sie przydzielic pamieci dla biletu narciarza #%d.\n", skier_id);
-        return NULL; // 
-    }
+#include "log.h"
+#include "config.h"
+#include "registry.h"
 
+// Zakup biletu zapisanego w rekordzie narciarza
+void purchase_ticket(Ticket* ticket, int skier_id, int age, Rng* rng) {
     ticket->ticket_id = skier_id;
-    ticket->usage_count = 0;
 
-    int ticket_type = rand() % 4;
+    int ticket_type = rng_below(rng, 4);
+    ticket->ticket_type = ticket_type;
     if (ticket_type == 3) {
-        ticket->expiry_time = (CLOSING_HOUR - OPENING_HOUR) * 60; // Bilet dzienny
+        ticket->expiry_time = (config.closing_hour - config.opening_hour) * 60; // Bilet dzienny
     } else {
         ticket->expiry_time = (ticket_type + 1) * 60; // Tk1, Tk2, Tk3
     }
 
-    ticket->is_vip = rand() % 5 == 0; // 20% szans na VIP
+    ticket->is_vip = rng_below(rng, 5) == 0; // 20% szans na VIP
 
-    if (age < 12 || age > 65) {
-        printf("\033[33mNarciarz #%d otrzymal znizke na karnet.\n\033[0m", skier_id);
+    DiscountClass discount = age < 12 ? DISCOUNT_CHILD : age > 65 ? DISCOUNT_SENIOR : DISCOUNT_NONE;
+    ticket->discount = discount;
+    if (discount != DISCOUNT_NONE) {
+        log_event(EV_DISCOUNT, skier_id, 0);
     }
 
-    return ticket;
+    // Bramki sprawdzają bilet w rejestrze, nie w rekordzie narciarza
+    registry_add(ticket->ticket_id, (sim_time_t)ticket->expiry_time * 60, ticket->is_vip, discount);
 }
\ No newline at end of file
@@ -2,19 +2,19 @@
 #define TICKET_H
 
 #include <stdbool.h>
+#include "rng.h"
+#include "registry.h"
 
-#define OPENING_HOUR 8
-#define CLOSING_HOUR 10
-
-// Struktura biletu
+// Struktura biletu (liczbę przejść prowadzi rejestr biletów)
 typedef struct {
     int ticket_id;      // ID karnetu
-    int usage_count;    // Liczba wykorzystanych przejazdów
     bool is_vip;        // Czy bilet jest VIP?
     int expiry_time;    // Czas ważności karnetu w minutach
+    int ticket_type;    // Rodzaj biletu: 0-2 to Tk1-Tk3, 3 to bilet dzienny
+    DiscountClass discount; // Zniżka wynikająca z wieku
 } Ticket;
 
 // Funkcje związane z biletami
-Ticket* purchase_ticket(int skier_id, int age);
+void purchase_ticket(Ticket* ticket, int skier_id, int age, Rng* rng);
 
 #endif
\ No newline at end of file
@@ -0,0 +1,155 @@
+#include <errno.h>
+#include <fcntl.h>
+#include <signal.h>
+#include <stdbool.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <time.h>
+#include <unistd.h>
+#include "monitor.h"
+#include "station.h"
+
+// Podgląd działającej stacji: odwzorowuje segment podglądu tylko do odczytu i kilka razy na sekundę
+// rysuje stan w terminalu. Nie zapisuje niczego w segmencie, więc stacja nie odczuwa obserwacji.
+
+#define TOP_DEFAULT_INTERVAL_MS 250
+#define TOP_READ_RETRIES 1000  // Próby spójnego odczytu, zanim podgląd uzna segment za uszkodzony
+
+static void usage(const char* program) {
+    fprintf(stderr, "Uzycie: %s [--name nazwa_segmentu] [--interval ms] [--once]\n", program);
+}
+
+// Spójna kopia danych segmentu: powtórzenie, gdy piszący był w trakcie zapisu albo zdążył zapisać nowy stan
+static bool read_snapshot(const MonitorHeader* header, unsigned char* copy, size_t size) {
+    for (int i = 0; i < TOP_READ_RETRIES; i++) {
+        unsigned before = atomic_load_explicit(&header->seq, memory_order_acquire);
+        if (before & 1) {
+            continue;
+        }
+        memcpy(copy + MONITOR_HEADER_SIZE, (const unsigned char*)header + MONITOR_HEADER_SIZE, size - MONITOR_HEADER_SIZE);
+        atomic_thread_fence(memory_order_acquire);
+        if (atomic_load_explicit(&header->seq, memory_order_relaxed) == before) {
+            return true;
+        }
+    }
+    return false;
+}
+
+// Krzesełka jadące w górę, od ostatnio załadowanego do górnej stacji (cyfra: liczba pasażerów)
+static void print_chairs(const unsigned char* occupancy, int num_chairs, int loading_chair) {
+    printf("  Lina (dol -> gora): ");
+    for (int i = 1; i <= num_chairs / 2; i++) {
+        int occupied = occupancy[(loading_chair - i + num_chairs) % num_chairs];
+        putchar(occupied == 0 ? '.' : occupied < 10 ? '0' + occupied : '+');
+    }
+    putchar('\n');
+}
+
+static void render(const MonitorHeader* header, const unsigned char* copy, bool clear) {
+    const MonitorStation* station = (const MonitorStation*)(copy + MONITOR_HEADER_SIZE);
+    const MonitorLift* lifts = (const MonitorLift*)(copy + monitor_lifts_offset());
+    const int32_t* depths = (const int32_t*)(copy + monitor_gates_offset(header->num_lifts));
+    const unsigned char* occupancy = copy + monitor_chairs_offset(header->num_lifts, header->num_gates);
+
+    if (clear) {
+        printf("\033[H\033[2J");
+    }
+    long clock = (long)header->opening_hour * 3600 + station->sim_time;
+    printf("ski_station (pid %d)  czas %02ld:%02ld:%02ld  %s  odczyt #%lld\n", header->pid, clock / 3600,
+           clock / 60 % 60, clock % 60,
+           station->finished ? "koniec pracy" : station->station_open ? "stacja otwarta" : "stacja zamknieta",
+           (long long)station->published);
+    printf("Dzis: narciarze %d, zjazdy %d, zatrzymania kolejek %d, na trasach %d.\n", station->skiers,
+           station->rides, station->lift_stops, station->on_slopes);
+    printf("Biezaca przepustowosc: bramki %.0f narciarzy/h, krzeselka %.0f miejsc/h.\n", station->gate_per_hour,
+           station->seats_per_hour);
+
+    for (int l = 0; l < header->num_lifts; l++) {
+        const MonitorLift* lift = &lifts[l];
+        const char* state = lift->state & LIFT_DRAINED ? "oprozniona"
+                          : lift->state & LIFT_RUNNING ? "jedzie" : "zatrzymana";
+        printf("\nKolejka #%d [%s]  peron %d/%d (czeka %d)  na krzeselkach %d  przewiezieni %lld\n", l, state,
+               lift->on_platform, header->max_people_on_platform, lift->platform_waiting, lift->on_chairs,
+               (long long)lift->carried);
+        printf("  Zatrzymania przez pracownika #%d: %lld\n", lift->worker_id, (long long)lift->stops);
+        printf("  Kolejki do bramek:");
+        for (int g = 0; g < header->num_gates; g++) {
+            printf(" #%d: %d", l * header->num_gates + g, depths[l * header->num_gates + g]);
+        }
+        putchar('\n');
+        print_chairs(&occupancy[(size_t)l * header->num_chairs], header->num_chairs, lift->loading_chair);
+    }
+    fflush(stdout);
+}
+
+int main(int argc, char* argv[]) {
+    const char* name = MONITOR_DEFAULT_NAME;
+    int interval_ms = TOP_DEFAULT_INTERVAL_MS;
+    bool once = false;
+    for (int i = 1; i < argc; i++) {
+        if (strcmp(argv[i], "--name") == 0 && i + 1 < argc) {
+            name = argv[++i];
+        } else if (strcmp(argv[i], "--interval") == 0 && i + 1 < argc) {
+            interval_ms = atoi(argv[++i]);
+        } else if (strcmp(argv[i], "--once") == 0) {
+            once = true;
+        } else {
+            usage(argv[0]);
+            return 1;
+        }
+    }
+    if (interval_ms <= 0) {
+        fprintf(stderr, "Blad: Odstep odswiezania musi byc dodatni.\n");
+        return 1;
+    }
+
+    int fd = shm_open(name, O_RDONLY, 0);
+    if (fd == -1) {
+        fprintf(stderr, "Blad: Brak segmentu podgladu %s (czy ski_station dziala?).\n", name);
+        return 1;
+    }
+    struct stat st;
+    if (fstat(fd, &st) == -1 || (size_t)st.st_size < MONITOR_HEADER_SIZE) {
+        fprintf(stderr, "Blad: Segment %s nie jest segmentem podgladu stacji.\n", name);
+        close(fd);
+        return 1;
+    }
+    size_t size = (size_t)st.st_size;
+    const MonitorHeader* header = mmap(NULL, size, PROT_READ, MAP_SHARED, fd, 0);
+    close(fd);
+    if (header == MAP_FAILED || memcmp(header->magic, MONITOR_MAGIC, sizeof(header->magic)) != 0 ||
+        header->size != size ||
+        monitor_size(header->num_lifts, header->num_gates, header->num_chairs) != size) {
+        fprintf(stderr, "Blad: Segment %s nie jest segmentem podgladu stacji.\n", name);
+        return 1;
+    }
+
+    unsigned char* copy = malloc(size);
+    if (!copy) {
+        fprintf(stderr, "Blad: Brak pamieci na kopie stanu stacji.\n");
+        return 1;
+    }
+    struct timespec pause = { interval_ms / 1000, (long)(interval_ms % 1000) * 1000000L };
+    while (true) {
+        if (!read_snapshot(header, copy, size)) {
+            fprintf(stderr, "Blad: Nie udalo sie odczytac spojnego stanu stacji.\n");
+            break;
+        }
+        render(header, copy, !once);
+        const MonitorStation* station = (const MonitorStation*)(copy + MONITOR_HEADER_SIZE);
+        if (once || station->finished) {
+            break;
+        }
+        if (kill(header->pid, 0) == -1 && errno == ESRCH) {
+            printf("\nProces stacji zakonczyl sie bez zamkniecia podgladu.\n");
+            break;
+        }
+        nanosleep(&pause, NULL);
+    }
+    free(copy);
+    munmap((void*)header, size);
+    return 0;
+}
@@ -0,0 +1,152 @@
+#include "trace.h"
+#include "config.h"
+#include "lockstat.h"
+#include <fcntl.h>
+#include <pthread.h>
+#include <stdio.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <unistd.h>
+
+#define TRACE_CHUNK_BYTES ((off_t)TRACE_CHUNK * (off_t)sizeof(TraceRecord))
+
+_Static_assert(sizeof(TraceRecord) == 16, "Rekord sladu musi zajmowac 16 bajtow");
+_Static_assert(sizeof(TraceHeader) <= TRACE_HEADER_SIZE, "Naglowek sladu jest za duzy");
+_Static_assert(TRACE_CHUNK % TRACE_BLOCK == 0, "Blok sladu nie moze przekraczac granicy przyrostu");
+
+static int trace_fd = -1;
+static TraceHeader* header = NULL;
+static TraceRecord* chunks[TRACE_MAX_CHUNKS];  // Odwzorowania kolejnych przyrostów pliku
+static atomic_int mapped_chunks;
+static pthread_mutex_t grow_mutex = PTHREAD_MUTEX_INITIALIZER;
+static sim_time_t (*trace_clock)(void) = NULL;
+static atomic_int trace_day;
+static atomic_uint trace_generation;            // Zmienia się przy każdym otwarciu pliku
+
+// Blok rekordów zarezerwowany przez bieżący wątek
+static __thread long long block_next;
+static __thread long long block_end;
+static __thread unsigned block_generation;
+
+// Powiększenie pliku i odwzorowanie kolejnych przyrostów aż do podanego włącznie
+static int trace_grow(int chunk) {
+    LOCK_MUTEX(&grow_mutex, LOCK_TRACE_GROW, 0);
+    int mapped = atomic_load_explicit(&mapped_chunks, memory_order_relaxed);
+    while (mapped <= chunk && mapped < TRACE_MAX_CHUNKS) {
+        off_t offset = TRACE_HEADER_SIZE + mapped * TRACE_CHUNK_BYTES;
+        if (ftruncate(trace_fd, offset + TRACE_CHUNK_BYTES) == -1) {
+            break;
+        }
+        void* area = mmap(NULL, TRACE_CHUNK_BYTES, PROT_READ | PROT_WRITE, MAP_SHARED, trace_fd, offset);
+        if (area == MAP_FAILED) {
+            break;
+        }
+        chunks[mapped] = area;
+        mapped++;
+        atomic_store_explicit(&mapped_chunks, mapped, memory_order_release);
+    }
+    pthread_mutex_unlock(&grow_mutex);
+    return mapped > chunk ? 0 : -1;
+}
+
+// Utworzenie pustego śladu w pliku
+int trace_open(const char* path) {
+    trace_fd = open(path, O_RDWR | O_CREAT | O_TRUNC, 0644);
+    if (trace_fd == -1) {
+        return -1;
+    }
+    if (ftruncate(trace_fd, TRACE_HEADER_SIZE) == -1) {
+        close(trace_fd);
+        trace_fd = -1;
+        return -1;
+    }
+    TraceHeader* mapped = mmap(NULL, TRACE_HEADER_SIZE, PROT_READ | PROT_WRITE, MAP_SHARED, trace_fd, 0);
+    if (mapped == MAP_FAILED) {
+        close(trace_fd);
+        trace_fd = -1;
+        return -1;
+    }
+
+    memcpy(mapped->magic, TRACE_MAGIC, sizeof(mapped->magic));
+    mapped->version = 1;
+    mapped->record_size = sizeof(TraceRecord);
+    atomic_init(&mapped->count, 0);
+    mapped->opening_hour = config.opening_hour;
+    mapped->day_length = (config.closing_hour - config.opening_hour) * 3600;
+    mapped->num_lifts = config.num_lifts;
+    mapped->num_gates = config.num_gates;
+    atomic_init(&mapped_chunks, 0);
+    atomic_store(&trace_day, 0);
+    atomic_fetch_add(&trace_generation, 1);
+    header = mapped;
+    return 0;
+}
+
+// Odłączenie śladu i obcięcie pliku do zarezerwowanych rekordów; plik zostaje na dysku
+void trace_close(void) {
+    if (!header) {
+        return;
+    }
+    long long count = atomic_load(&header->count);
+    int mapped = atomic_load(&mapped_chunks);
+    for (int i = 0; i < mapped; i++) {
+        munmap(chunks[i], TRACE_CHUNK_BYTES);
+        chunks[i] = NULL;
+    }
+    atomic_store(&mapped_chunks, 0);
+    if (count > (long long)mapped * TRACE_CHUNK) {
+        count = (long long)mapped * TRACE_CHUNK;
+        atomic_store(&header->count, count);
+    }
+    munmap(header, TRACE_HEADER_SIZE);
+    header = NULL;
+    if (ftruncate(trace_fd, TRACE_HEADER_SIZE + count * (off_t)sizeof(TraceRecord)) == -1) {
+        fprintf(stderr, "Blad: Nie udalo sie obciac pliku sladu.\n");
+    }
+    close(trace_fd);
+    trace_fd = -1;
+}
+
+void trace_set_clock(sim_time_t (*clock)(void)) {
+    trace_clock = clock;
+}
+
+// Kolejny dzień symulacji (wywoływane przy otwarciu stacji)
+void trace_begin_day(void) {
+    atomic_fetch_add(&trace_day, 1);
+}
+
+// Miejsce na rekord w bloku wątku; nowy blok rezerwowany jednym atomowym dodawaniem
+static TraceRecord* trace_slot(void) {
+    unsigned generation = atomic_load_explicit(&trace_generation, memory_order_relaxed);
+    if (block_next == block_end || block_generation != generation) {
+        long long first = atomic_fetch_add_explicit(&header->count, TRACE_BLOCK, memory_order_relaxed);
+        int chunk = (int)(first / TRACE_CHUNK);
+        if (chunk >= TRACE_MAX_CHUNKS ||
+            (chunk >= atomic_load_explicit(&mapped_chunks, memory_order_acquire) && trace_grow(chunk) == -1)) {
+            return NULL;
+        }
+        block_next = first;
+        block_end = first + TRACE_BLOCK;
+        block_generation = generation;
+    }
+    long long index = block_next++;
+    return &chunks[index / TRACE_CHUNK][index % TRACE_CHUNK];
+}
+
+// Zapis zdarzenia bezpośrednio do odwzorowanego pliku
+void trace_record(TraceEventType type, int skier_id, int lift, int arg) {
+    if (!header) {
+        return;
+    }
+    TraceRecord* record = trace_slot();
+    if (!record) {
+        return;
+    }
+    record->time = (uint32_t)(trace_clock ? trace_clock() : 0);
+    record->day = (uint16_t)atomic_load_explicit(&trace_day, memory_order_relaxed);
+    record->lift = (uint8_t)lift;
+    record->skier_id = skier_id;
+    record->arg = arg;
+    record->type = (uint8_t)type;
+}
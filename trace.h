@@ -0,0 +1,65 @@
+#ifndef TRACE_H
+#define TRACE_H
+
+#include <stdatomic.h>
+#include <stdint.h>
+#include "des.h"
+
+// Układ pliku śladu (czyta go narzędzie ski_replay):
+//   [TraceHeader, dopełniony do TRACE_HEADER_SIZE][rekord 0][rekord 1]...
+// Wątki rezerwują bloki po TRACE_BLOCK rekordów; niewykorzystane miejsca bloków mają typ TRACE_NONE.
+#define TRACE_MAGIC "SKITRAC1"
+#define TRACE_HEADER_SIZE 4096
+#define TRACE_BLOCK 256          // Rekordów rezerwowanych naraz przez jeden wątek
+#define TRACE_CHUNK 65536        // Rekordów w jednym przyroście pliku
+#define TRACE_MAX_CHUNKS 4096
+
+// Zdarzenia cyklu życia narciarza i kolejki
+typedef enum {
+    TRACE_NONE,        // Wolne miejsce w bloku
+    TRACE_TICKET,      // Zakup biletu (arg: typ biletu, +256 dla VIP)
+    TRACE_GATE_QUEUE,  // Ustawienie się w kolejce do bramki (arg: bramka)
+    TRACE_GATE_PASS,   // Przejście przez bramkę (arg: bramka)
+    TRACE_REJECTED,    // Odrzucony bilet (arg: bramka)
+    TRACE_CLOSED,      // Po przejściu przez bramkę stacja była już zamknięta
+    TRACE_PLATFORM,    // Wejście na peron
+    TRACE_BOARD,       // Wejście na krzesełko (arg: 1 dla VIP)
+    TRACE_ALIGHT,      // Zejście z krzesełka na górze
+    TRACE_TRAIL,       // Wybór trasy (arg: trasa 0-2, lift: kolejka, z której rusza)
+    TRACE_DESCENT_END, // Koniec zjazdu (arg: trasa 0-2, lift: kolejka docelowa)
+    TRACE_DONE,        // Koniec dnia narciarza (także odrzuconego przy zakupie biletu)
+    TRACE_LIFT_STOP,   // Zatrzymanie kolejki (skier_id: -1, arg: pracownik)
+    TRACE_LIFT_RESUME, // Wznowienie kolejki (skier_id: -1, arg: pracownik)
+    TRACE_TYPES
+} TraceEventType;
+
+// Rekord o stałym rozmiarze 16 bajtów
+typedef struct {
+    uint32_t time;     // Czas symulowany od otwarcia stacji (s)
+    uint16_t day;      // Dzień symulacji (od 1)
+    uint8_t type;      // TraceEventType
+    uint8_t lift;      // Kolejka
+    int32_t skier_id;
+    int32_t arg;
+} TraceRecord;
+
+// Nagłówek śladu z parametrami potrzebnymi do analizy
+typedef struct {
+    char magic[8];
+    uint32_t version;
+    uint32_t record_size;
+    atomic_llong count;       // Zarezerwowane rekordy (z wolnymi miejscami bloków)
+    int32_t opening_hour;
+    int32_t day_length;       // Długość dnia (s)
+    int32_t num_lifts;
+    int32_t num_gates;        // Bramek jednej kolejki
+} TraceHeader;
+
+// Funkcje śladu (bez otwartego pliku zapis jest pomijany)
+int trace_open(const char* path);
+void trace_close(void);
+void trace_set_clock(sim_time_t (*clock)(void));
+void trace_begin_day(void);
+void trace_record(TraceEventType type, int skier_id, int lift, int arg);
+
+#endif
@@ -0,0 +1,209 @@
+#include "usage.h"
+#include "config.h"
+#include <pthread.h>
+#include <stdatomic.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+// Komórka dla każdego połączenia biletu, wieku, zniżki i klasy
+#define USAGE_CELLS (USAGE_TICKETS * USAGE_AGES * USAGE_DISCOUNTS * 2)
+
+// Liczniki jednego wątku: zapisuje tylko właściciel, odczyt scala wszystkie wątki
+typedef struct UsageThread {
+    atomic_uint_least64_t skiers[USAGE_CELLS];
+    atomic_uint_least64_t rides[USAGE_CELLS];
+    atomic_uint_least64_t hours[USAGE_HOURS];
+    struct UsageThread* next;  // Lista liczników wszystkich wątków
+} UsageThread;
+
+static const char* ticket_names[USAGE_TICKETS] = { "Tk1", "Tk2", "Tk3", "dzienny" };
+static const char* age_names[USAGE_AGES] = { "4-8", "9-17", "18-65", "66+" };
+static const char* discount_names[USAGE_DISCOUNTS] = { "brak", "dziecieca", "seniorska" };
+static const char* class_names[2] = { "zwykli", "VIP" };
+
+static pthread_mutex_t threads_mutex = PTHREAD_MUTEX_INITIALIZER;
+static UsageThread* threads = NULL;
+static __thread UsageThread* thread_usage = NULL;
+
+static UsageThread* get_thread_usage(void) {
+    if (thread_usage) {
+        return thread_usage;
+    }
+    UsageThread* usage = calloc(1, sizeof(UsageThread));
+    if (!usage) {
+        return NULL;
+    }
+    pthread_mutex_lock(&threads_mutex);
+    usage->next = threads;
+    threads = usage;
+    pthread_mutex_unlock(&threads_mutex);
+    thread_usage = usage;
+    return usage;
+}
+
+static int age_bracket(int age) {
+    return age <= 8 ? 0 : age <= 17 ? 1 : age <= 65 ? 2 : 3;
+}
+
+static int cell_of(const Skier* skier) {
+    int cell = skier->ticket.ticket_type;
+    cell = cell * USAGE_AGES + age_bracket(skier->age);
+    cell = cell * USAGE_DISCOUNTS + skier->ticket.discount;
+    return cell * 2 + (skier->ticket.is_vip ? 1 : 0);
+}
+
+// Zwiększenie licznika przez jedynego piszącego (bez operacji read-modify-write)
+static void bump(atomic_uint_least64_t* counter) {
+    atomic_store_explicit(counter, atomic_load_explicit(counter, memory_order_relaxed) + 1, memory_order_relaxed);
+}
+
+// Narciarz dopuszczony na stację
+void usage_add_skier(const Skier* skier) {
+    UsageThread* usage = get_thread_usage();
+    if (usage) {
+        bump(&usage->skiers[cell_of(skier)]);
+    }
+}
+
+// Zjazd narciarza w chwili zejścia z krzesełka
+void usage_add_ride(const Skier* skier, sim_time_t now) {
+    UsageThread* usage = get_thread_usage();
+    if (!usage) {
+        return;
+    }
+    int hour = (int)(now / 3600);
+    bump(&usage->rides[cell_of(skier)]);
+    bump(&usage->hours[hour < USAGE_HOURS ? hour : USAGE_HOURS - 1]);
+}
+
+// Scalenie liczników wszystkich wątków i zsumowanie po każdym wymiarze
+void usage_snapshot(UsageSnapshot* out) {
+    memset(out, 0, sizeof(*out));
+    pthread_mutex_lock(&threads_mutex);
+    for (UsageThread* usage = threads; usage; usage = usage->next) {
+        for (int cell = 0; cell < USAGE_CELLS; cell++) {
+            uint64_t skiers = atomic_load_explicit(&usage->skiers[cell], memory_order_relaxed);
+            uint64_t rides = atomic_load_explicit(&usage->rides[cell], memory_order_relaxed);
+            int vip = cell % 2;
+            int discount = cell / 2 % USAGE_DISCOUNTS;
+            int age = cell / 2 / USAGE_DISCOUNTS % USAGE_AGES;
+            int ticket = cell / 2 / USAGE_DISCOUNTS / USAGE_AGES;
+            UsageCount* groups[] = { &out->total, &out->ticket[ticket], &out->age[age],
+                                     &out->discount[discount], &out->vip[vip] };
+            for (size_t g = 0; g < sizeof(groups) / sizeof(groups[0]); g++) {
+                groups[g]->skiers += skiers;
+                groups[g]->rides += rides;
+            }
+        }
+        for (int hour = 0; hour < USAGE_HOURS; hour++) {
+            out->hours[hour] += atomic_load_explicit(&usage->hours[hour], memory_order_relaxed);
+        }
+    }
+    pthread_mutex_unlock(&threads_mutex);
+}
+
+// Format na podstawie nazwy z linii poleceń
+int usage_parse_format(const char* name, UsageFormat* format) {
+    static const char* names[] = { "text", "csv", "json" };
+    for (int i = 0; i <= USAGE_JSON; i++) {
+        if (strcmp(name, names[i]) == 0) {
+            *format = (UsageFormat)i;
+            return 0;
+        }
+    }
+    return -1;
+}
+
+static void print_text_group(const char* title, const char* const* names, const UsageCount* counts, int count) {
+    printf("- %s:", title);
+    for (int i = 0; i < count; i++) {
+        printf("%s %s: %llu narc. / %llu zjazdow", i ? ";" : "", names[i], (unsigned long long)counts[i].skiers,
+               (unsigned long long)counts[i].rides);
+    }
+    printf(".\n");
+}
+
+static void print_csv_group(const char* dimension, const char* const* names, const UsageCount* counts, int count) {
+    for (int i = 0; i < count; i++) {
+        printf("%s,%s,%llu,%llu\n", dimension, names[i], (unsigned long long)counts[i].skiers,
+               (unsigned long long)counts[i].rides);
+    }
+}
+
+static void print_json_group(const char* dimension, const char* const* names, const UsageCount* counts, int count) {
+    printf(",\"%s\":{", dimension);
+    for (int i = 0; i < count; i++) {
+        printf("%s\"%s\":{\"skiers\":%llu,\"rides\":%llu}", i ? "," : "", names[i],
+               (unsigned long long)counts[i].skiers, (unsigned long long)counts[i].rides);
+    }
+    putchar('}');
+}
+
+// Raport przejazdów w podanym formacie; koszt zależy tylko od liczby wątków, nie narciarzy
+void usage_print_report(UsageFormat format) {
+    UsageSnapshot usage;
+    usage_snapshot(&usage);
+    unsigned long long skiers = usage.total.skiers;
+    unsigned long long rides = usage.total.rides;
+
+    if (format == USAGE_CSV) {
+        printf("wymiar,grupa,narciarze,zjazdy\n");
+        printf("lacznie,wszyscy,%llu,%llu\n", skiers, rides);
+        print_csv_group("bilet", ticket_names, usage.ticket, USAGE_TICKETS);
+        print_csv_group("wiek", age_names, usage.age, USAGE_AGES);
+        print_csv_group("znizka", discount_names, usage.discount, USAGE_DISCOUNTS);
+        print_csv_group("klasa", class_names, usage.vip, 2);
+        for (int hour = 0; hour < USAGE_HOURS; hour++) {
+            if (usage.hours[hour] > 0) {
+                printf("godzina,%02d,,%llu\n", config.opening_hour + hour, (unsigned long long)usage.hours[hour]);
+            }
+        }
+    } else if (format == USAGE_JSON) {
+        printf("{\"skiers\":%llu,\"rides\":%llu", skiers, rides);
+        print_json_group("ticket", ticket_names, usage.ticket, USAGE_TICKETS);
+        print_json_group("age", age_names, usage.age, USAGE_AGES);
+        print_json_group("discount", discount_names, usage.discount, USAGE_DISCOUNTS);
+        print_json_group("class", class_names, usage.vip, 2);
+        printf(",\"hours\":{");
+        bool first = true;
+        for (int hour = 0; hour < USAGE_HOURS; hour++) {
+            if (usage.hours[hour] > 0) {
+                printf("%s\"%02d\":%llu", first ? "" : ",", config.opening_hour + hour,
+                       (unsigned long long)usage.hours[hour]);
+                first = false;
+            }
+        }
+        printf("}}\n");
+    } else {
+        printf("\n[Raport przejazdow]\n");
+        printf("- Narciarze: %llu, zjazdy: %llu (srednio %.2f na narciarza).\n", skiers, rides,
+               skiers > 0 ? (double)rides / skiers : 0.0);
+        print_text_group("Bilety", ticket_names, usage.ticket, USAGE_TICKETS);
+        print_text_group("Wiek", age_names, usage.age, USAGE_AGES);
+        print_text_group("Znizki", discount_names, usage.discount, USAGE_DISCOUNTS);
+        print_text_group("Klasy", class_names, usage.vip, 2);
+        printf("- Zjazdy w godzinach:");
+        bool first = true;
+        for (int hour = 0; hour < USAGE_HOURS; hour++) {
+            if (usage.hours[hour] > 0) {
+                printf("%s %02d: %llu", first ? "" : ",", config.opening_hour + hour, (unsigned long long)usage.hours[hour]);
+                first = false;
+            }
+        }
+        printf("%s.\n", first ? " brak" : "");
+    }
+    fflush(stdout);
+}
+
+// Zwolnienie liczników wszystkich wątków
+void usage_destroy(void) {
+    pthread_mutex_lock(&threads_mutex);
+    while (threads) {
+        UsageThread* next = threads->next;
+        free(threads);
+        threads = next;
+    }
+    pthread_mutex_unlock(&threads_mutex);
+    thread_usage = NULL;
+}
@@ -0,0 +1,43 @@
+#ifndef USAGE_H
+#define USAGE_H
+
+#include <stdint.h>
+#include "station.h"
+
+#define USAGE_TICKETS 4    // Tk1-Tk3 i bilet dzienny
+#define USAGE_AGES 4       // Przedziały wieku: 4-8, 9-17, 18-65, 66+
+#define USAGE_DISCOUNTS 3  // DiscountClass
+#define USAGE_HOURS 24     // Godziny od otwarcia stacji (ostatnia zbiera późniejsze)
+
+// Format raportu
+typedef enum {
+    USAGE_TEXT,
+    USAGE_CSV,
+    USAGE_JSON
+} UsageFormat;
+
+// Narciarze i zjazdy w jednej grupie
+typedef struct {
+    uint64_t skiers;
+    uint64_t rides;
+} UsageCount;
+
+// Scalone liczniki wszystkich wątków; rozmiar nie zależy od liczby narciarzy
+typedef struct {
+    UsageCount total;
+    UsageCount ticket[USAGE_TICKETS];
+    UsageCount age[USAGE_AGES];
+    UsageCount discount[USAGE_DISCOUNTS];
+    UsageCount vip[2];               // 0: zwykli, 1: VIP
+    uint64_t hours[USAGE_HOURS];     // Zjazdy w kolejnych godzinach
+} UsageSnapshot;
+
+// Funkcje statystyk przejazdów (zapis bez blokad, jak w histogramach)
+void usage_add_skier(const Skier* skier);
+void usage_add_ride(const Skier* skier, sim_time_t now);
+void usage_snapshot(UsageSnapshot* out);
+int usage_parse_format(const char* name, UsageFormat* format);
+void usage_print_report(UsageFormat format);
+void usage_destroy(void);
+
+#endif